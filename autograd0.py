@@ -1,6 +1,9 @@
 '''
 http://utkuevci.com/ml/autograd/
 '''
+import math
+import numpy as np
+
 class Variable():
 	__counter = 0
 
@@ -104,6 +107,46 @@ def relu(a):  # backward_fun of the relu is just the masking.
 	res.prev.append(a)
 	return res
 
+# The other activation fns of ncc (codes 0-6: identity, sigmoid, tanh, relu, silu, gelu, swish), so that the reference covers every fj. Each backward_fun scales dy by the derivative at the input.
+def sigmoid(a):
+	if not (isinstance(a,Variable)):  raise ValueError('a needs to be a Variable')
+	s = 1/(1+np.exp(-a.data))
+	def b_fun(dy=1):  a.grad += dy*s*(1-s)
+
+	res = Variable(s,is_leaf=False,backward_fun=b_fun)
+	res.prev.append(a)
+	return res
+
+def tanh(a):
+	if not (isinstance(a,Variable)):  raise ValueError('a needs to be a Variable')
+	t = np.tanh(a.data)
+	def b_fun(dy=1):  a.grad += dy*(1-t*t)
+
+	res = Variable(t,is_leaf=False,backward_fun=b_fun)
+	res.prev.append(a)
+	return res
+
+def swish(a,beta=1.0):  # silu is swish w/ beta 1
+	if not (isinstance(a,Variable)):  raise ValueError('a needs to be a Variable')
+	s = 1/(1+np.exp(-beta*a.data))
+	def b_fun(dy=1):  a.grad += dy*s*(1+beta*a.data*(1-s))
+
+	res = Variable(a.data*s,is_leaf=False,backward_fun=b_fun)
+	res.prev.append(a)
+	return res
+
+def silu(a):  return swish(a,1.0)
+
+def gelu(a):  # the exact (erf) gelu, not the tanh approximation
+	if not (isinstance(a,Variable)):  raise ValueError('a needs to be a Variable')
+	erf = np.vectorize(math.erf)
+	c   = 0.5*(1+erf(a.data/math.sqrt(2)))
+	def b_fun(dy=1):  a.grad += dy*(c + a.data*np.exp(-0.5*a.data*a.data)/math.sqrt(2*math.pi))
+
+	res = Variable(a.data*c,is_leaf=False,backward_fun=b_fun)
+	res.prev.append(a)
+	return res
+
 def transpose(a):
 	if not (isinstance(a,Variable)):  raise ValueError('a needs to be a Variable')
 	def b_fun(dy=1):
@@ -0,0 +1,117 @@
+'''
+check the bwd-pass of ncc -g against autograd0.py: compile a net w/ ncc -g, run fwd() and bwd() on random x, w and dy, and compare y, dw and dx to the same graph built from autograd0 Variables (1 scalar Variable per neuron and per edge, in float64)
+the nets: nn00.nal, and a random DAG w/ every activation fn (codes 0-6) and a dense layer (a GEMV block in the generated code), each w/ straight-line code and w/ CSR loops (-u 0)
+a value passes if |ncc - ref| <= RTOL*max(1,|ref|), since ncc runs in float32 and the reference in float64
+
+	python3 gradchk.py [path/to/ncc]
+'''
+import os, sys, subprocess, tempfile
+import numpy as np
+import autograd0 as ag
+
+RTOL = 1e-5
+CC   = os.environ.get('CC','cc')
+
+# the driver: read x, w, dy from dir, run fwd() and bwd(), and write y, dw, dx to dir, all as raw float32
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+void fwd(const float* x, float* y, const float* w);
+void bwd(const float* dy, const float* w, float* dw, float* dx);
+__attribute__((weak)) int ncc_init(const char* path);
+static char* pth(const char* dir, const char* name){  static char p[4096];  snprintf(p,sizeof(p), "%s/%s", dir,name);  return p;  }
+static float* rd(const char* dir, const char* name, long n){  float* a=calloc(n+1,4);  FILE* f=fopen(pth(dir,name),"rb");  if(f==NULL || fread(a,4,n,f)!=(size_t)n)  exit(1);  fclose(f);  return a;  }
+static void   wr(const char* dir, const char* name, const float* a, long n){  FILE* f=fopen(pth(dir,name),"wb");  fwrite(a,4,n,f);  fclose(f);  }
+int main(int nargs, char* args[]){
+	const char* dir=args[1];  long NX=atol(args[2]), NY=atol(args[3]), E=atol(args[4]);
+	if(ncc_init && ncc_init(pth(dir,"net.csr"))!=0)  return 2;
+	float *x=rd(dir,"x",NX), *w=rd(dir,"w",E), *dy=rd(dir,"dy",NY), *y=calloc(NY+1,4), *dw=calloc(E+1,4), *dx=calloc(NX+1,4);
+	fwd(x,y,w);
+	bwd(dy,w,dw,dx);
+	wr(dir,"y",y,NY);  wr(dir,"dw",dw,E);  wr(dir,"dx",dx,NX);
+	return 0;
+}
+'''
+
+ACTS = [lambda a:a, ag.sigmoid, ag.tanh, ag.relu, ag.silu, ag.gelu, ag.swish]  # by activation fn code
+
+def nalparse(path):  # @ret F, I: the activation fn code and the in-indices of each neuron
+	F,I = [],[]
+	for line in open(path):
+		tok = line.split()
+		if len(tok)==0 or tok[0][0] in '%Nn':  continue
+		assert int(tok[0],16)==len(F), f'{path}: neuron {tok[0]} is out of order'
+		F.append(int(tok[1],16) if 1<len(tok) else 0)
+		I.append([int(i,16) for i in tok[2].split(',')] if 2<len(tok) else [])
+	return F,I
+
+def nalsave(path, F,I):
+	with open(path,'w') as fp:
+		fp.write(f'N {len(F):x}\n')
+		for j in range(len(F)):  fp.write(f'{j:02x}\n' if len(I[j])==0 else f'{j:02x} {F[j]:02x} '+','.join(f'{i:02x}' for i in I[j])+'\n')
+
+def dag(rng, NX=6, N=48, D=16):  # NX inputs, a dense layer of D neurons over all of them (runs of 4 w/ the same activation fn, so they're GEMV blocks), and then random in-sets over everything before, w/ every activation fn
+	F = [0]*NX + [(j//4)%7 for j in range(D)]
+	I = [[] for j in range(NX)] + [list(range(NX)) for j in range(D)]
+	for j in range(NX+D,N):
+		F.append(j%7)
+		I.append(sorted(rng.choice(j, size=rng.integers(1,6), replace=False).tolist()))
+	return F,I
+
+def outputs(I):  # the output neurons (in -indices, but no out-indices), in neuron order, like the y of fwd()
+	used = {i for Ij in I for i in Ij}
+	return [j for j in range(len(I)) if len(I[j])!=0 and j not in used]
+
+def ref(F,I, x,w,dy):  # the graph in autograd0: @ret y, dw, dx
+	N  = len(F)
+	X  = [ag.Variable(float(v)) for v in x]
+	W  = [ag.Variable(float(v)) for v in w]
+	n  = [None]*N
+	e  = k = 0
+	for j in range(N):
+		if len(I[j])==0:  n[j]=X[k];  k+=1;  continue
+		acc = None
+		for i in I[j]:
+			t   = ag.multiply(n[i],W[e]);  e+=1
+			acc = t if acc is None else ag.plus(acc,t)
+		n[j] = ACTS[F[j]](acc)
+	O    = outputs(I)
+	loss = None
+	for k,j in enumerate(O):  # d loss/d y[k] is dy[k]
+		t    = ag.multiply(n[j], ag.Variable(float(dy[k])))
+		loss = t if loss is None else ag.plus(loss,t)
+	ag.backward_graph(loss)
+	return np.array([n[j].data[0] for j in O]), np.array([v.grad[0] for v in W]), np.array([v.grad[0] for v in X])
+
+def check(ncc, path, flags, rng):
+	F,I = nalparse(path)
+	NX  = sum(len(i)==0 for i in I)
+	E   = sum(len(i) for i in I)
+	x   = rng.uniform(-1,1, NX).astype(np.float32)
+	w   = rng.uniform(-0.5,0.5, E).astype(np.float32)
+	dy  = rng.uniform(-1,1, len(outputs(I))).astype(np.float32)
+	with tempfile.TemporaryDirectory() as dir:
+		subprocess.run([ncc,'-q','-g',*flags,'-o',f'{dir}/net.c',path], check=True)
+		open(f'{dir}/h.c','w').write(HARNESS)
+		subprocess.run([CC,'-O2','-o',f'{dir}/h',f'{dir}/h.c',f'{dir}/net.c','-lm'], check=True)
+		for name,a in (('x',x),('w',w),('dy',dy)):  a.tofile(f'{dir}/{name}')
+		subprocess.run([f'{dir}/h',dir,str(NX),str(len(dy)),str(E)], check=True)
+		got = [np.fromfile(f'{dir}/{name}',np.float32) for name in ('y','dw','dx')]
+	exp = ref(F,I, x.astype(np.float64),w.astype(np.float64),dy.astype(np.float64))
+	ok  = True
+	for name,g,r in zip(('y','dw','dx'),got,exp):
+		err = np.max(np.abs(g-r)/np.maximum(1,np.abs(r)), initial=0)
+		ok &= bool(err<=RTOL)
+		tag  = '\x1b[92mok  ' if err<=RTOL else '\x1b[91mFAIL'
+		print(f'{tag}  \x1b[0m{path} {" ".join(flags):5}  {name:2}  \x1b[34m{len(g):5}  \x1b[0merr \x1b[32m{err:.2e}\x1b[0m')
+	return ok
+
+if __name__=='__main__':
+	sys.setrecursionlimit(1<<16)  # autograd0 sorts the graph recursively
+	here = os.path.dirname(os.path.abspath(__file__))
+	ncc  = os.path.abspath(sys.argv[1]) if 1<len(sys.argv) else os.path.join(here,'ncc')
+	rng  = np.random.default_rng(0)
+	with tempfile.TemporaryDirectory() as dir:
+		nalsave(f'{dir}/dag.nal', *dag(rng))
+		ok = all([check(ncc, path, flags, rng) for path in (os.path.join(here,'nn00.nal'), f'{dir}/dag.nal') for flags in ([],['-u','0'])])
+	sys.exit(0 if ok else 1)
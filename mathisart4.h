@@ -298,7 +298,7 @@ void* aligned_alloc(size_t alignment, size_t size){
 // fdefi int __builtin_ffs(int x){}
 fdefi int      __builtin_ctz(     unsigned int x){  int r;  asm("bsf %1, %0" : "=r"(r) : "rm"(x) : "cc");  return r;          }  // get the bit-index of the lsb (bit) set (in true-order)
 fdefi int      __builtin_clz(     unsigned int x){  int r;  asm("bsr %1, %0" : "=r"(r) : "rm"(x) : "cc");  return r^0b11111;  }  // get the bit-index of the msb (bit) set (in true-order)
-fdefi int      __builtin_popcount(unsigned int x){  }
+fdefi int      __builtin_popcount(unsigned int x){  x-=(x>>1)&0x55555555u;  x=(x&0x33333333u)+((x>>2)&0x33333333u);  return (((x+(x>>4))&0x0f0f0f0fu)*0x01010101u)>>24;  }  // SWAR popcount
 // fdefi int      __builtin_parity(  unsigned int x){  }
 // fdefi int      __builtin_clrsb(   int x){}
 fdefi uint32_t __builtin_bswap32( uint32_t     x){  uint32_t r;  asm("bswap %0"   : "=r"(r) : "0"(x));   return r;            }
@@ -1355,6 +1355,69 @@ fdefi void bitflip(volatile void* bit_field, i64 bit_idx){
 	data32[idx_quo32]   ^= 1<<idx_rem32;
 }
 
+/*
+bit matrices: an n*n bit matrix A is packed row-major into u32 words, C=divceilu(n,32) words per row, least-significant bit first: bit j of row i is `A[i*C + j/32]>>(j%32) & 1`. the padding bits (columns n..32*C) must be 0
+the transpose goes 1 32*32 block at a time w/ the recursive swap trick (Hacker's Delight 7-3): swap the off-diagonal 16*16 blocks, then the off-diagonal 8*8 blocks of each 16*16 block, etc. log2(32)=5 steps of 16 row-pair xor-swaps each
+*/
+fdef void bittr32(u32* a){  // @meta  in-place 32*32 bit-matrix transpose: bit j of a[i] goes to bit i of a[j]
+	u32 m = 0x0000ffffu;
+	for(int j=16; j!=0; j>>=1, m^=m<<j)
+		for(int k=0; k<32; k=(k+j+1)&~j){
+			u32 t   = ((a[k]>>j) ^ a[k+j]) & m;
+			a[k]   ^= t<<j;
+			a[k+j] ^= t;
+		}
+}
+
+#if defined(__AVX2__)
+#include <x86intrin.h>
+fdef void bittr32x8_avx2(__m256i* a){  // @meta  8 in-place 32*32 bit-matrix transposes at once, 1 per 32-bit lane: same swap trick as @bittr32(), on 8 blocks side by side
+	__m256i m = _mm256_set1_epi32(0x0000ffff);
+	for(int j=16; j!=0; j>>=1, m=_mm256_xor_si256(m,_mm256_slli_epi32(m,j)))
+		for(int k=0; k<32; k=(k+j+1)&~j){
+			__m256i t = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi32(a[k],j),a[k+j]), m);
+			a[k]      = _mm256_xor_si256(a[k],  _mm256_slli_epi32(t,j));
+			a[k+j]    = _mm256_xor_si256(a[k+j],t);
+		}
+}
+#endif
+
+fdef void bitmat_tr(i64 n,u32* A, u32* T){  // @meta  T = transpose(A), for n*n bit matrices. @T must have room for n*divceilu(n,32) words
+	i64 C = divceilu(n,32);
+	i64 J = 0;  // col block of A, ie. row block of T. walk T in row order, so that the writes stay in a few hundred cache lines
+#if defined(__AVX2__)
+	for(; J+8<=C; J+=8){  // 8 col blocks at a time: row r of blocks J..J+7 is 1 256-bit load
+		for(i64 I=0; I<C; ++I){  // row block of A
+			i64 nr = mmin(32, n-32*I);
+			__m256i a[32];  u32 t[8];
+			for(int r=0; r<32; ++r)  a[r] = r<nr ? _mm256_loadu_si256((__m256i*)(A + (32*I+r)*C + J)) : _mm256_setzero_si256();
+			bittr32x8_avx2(a);
+			for(int c=0; c<32; ++c){
+				_mm256_storeu_si256((__m256i*)t, a[c]);
+				for(int b=0; b<8; ++b)  if(32*(J+b)+c<n)  T[(32*(J+b)+c)*C + I] = t[b];
+			}
+		}
+	}
+#endif
+	for(; J<C; ++J)
+		for(i64 I=0; I<C; ++I){
+			i64 nr = mmin(32, n-32*I);
+			u32 a[32]={0};
+			for(int r=0; r<nr; ++r)  a[r] = A[(32*I+r)*C + J];
+			bittr32(a);
+			for(int c=0; c<32 && 32*J+c<n; ++c)  T[(32*J+c)*C + I] = a[c];
+		}
+}
+
+fdef void bitmat_pop(i64 n,u32* A, u32* deg){  // @meta  deg[i] = number of bits set in row i: the out-degrees of A, or the in-degrees if A is a transpose
+	i64 C = divceilu(n,32);
+	for(i64 i=0; i<n; ++i){
+		u32 d = 0;
+		for(i64 k=0; k<C; ++k)  d += __builtin_popcount(A[i*C+k]);
+		deg[i] = d;
+	}
+}
+
 // ----------------------------------------------------------------------------------------------------------------------------# @blk1  libfile
 #include <fcntl.h>     // @open()
 #include <unistd.h>    // @ftruncate()
@@ -1635,7 +1698,7 @@ tdef{
 	i64 _idx = vidim(V);                                  \
 	i64 _n   = _idx+(K);                                  \
 	v_maygrown((V), 2*_n+1);                              \
-	for(i64 _i=0; _i<_n; ++_i)  (V)[_idx+_i]=(DATA)[_i];  \
+	for(i64 _i=0; _i<(K); ++_i)  (V)[_idx+_i]=(DATA)[_i];  \
 	vidim(V) = _n;                                        \
 }while(0)
 
@@ -2514,6 +2577,17 @@ fdef pid_t exec4(char* args[]){  /*launch a process SYNCHRONOUSLY and don't sile
 	return pid;
 }
 
+fdef i64 execpool(i64 n, char** args[], i64 nprocs){  /*launch @n processes (the i-th one is @args[i]), at most @nprocs at a time, via @exec(), and wait for all of them. Return the number of them that failed (ie. didn't exit w/ status 0). NOTE! It reaps w/ @wait(), so the caller must have no other children running!*/
+	i64 nrun=0, nfail=0;
+	int st;
+	mfor(i,0,n){
+		if(nrun==mmax(nprocs,1)){  chks(wait(&st));  --nrun;  nfail += !WIFEXITED(st) || WEXITSTATUS(st)!=0;  }
+		exec(args[i]);  ++nrun;
+	}
+	for(; 0<nrun; --nrun){  chks(wait(&st));  nfail += !WIFEXITED(st) || WEXITSTATUS(st)!=0;  }
+	return nfail;
+}
+
 // ----------------------------------------------------------------------------------------------------------------------------# @blk1  libfp: a library for floats!
 #if defined(M_FP)
 /*
@@ -2746,6 +2820,276 @@ fdefi void showf64b( f64 x){  showf64bb( x);  }
 fdefi void showf128b(f64 x){  showf128bb(x);  }
 #endif  // M_FP
 
+// ---------------------------------------------------------------  fp activations: the NAL activation fns (codes 0 identity, 1 sigmoid, 2 tanh, 3 relu, 4 silu, 5 gelu, 6 swish) and their derivatives, over 16 floats at a time
+/*
+written once, w/ GCC vector extensions (gcc, clang), which lower f32x16 to 1 zmm under AVX-512, 2 ymm under AVX2, and 4 xmm otherwise. vectors only go by pointer, since a 64-byte vector by value changes the ABI w/o AVX-512
+each kernel is range-reduced, so the polynomials and rational fns only ever see a short interval:
+	- exp(x) = 2^k * exp(r), k = round(x/ln2), r = x-k*ln2 in [-ln2/2..ln2/2] (Cody-Waite: ln2 in 2 parts, so k*ln2_hi is exact), exp(r) a degree-7 polynomial (cephes). 2^k is applied in 2 halves, so subnormal results underflow gradually. below ln(2^-150) it's 0
+	- tanh(x) = x*(1+x^2*P(x^2)) for |x|<0.625 (cephes), else 1-2/(exp(2|x|)+1) w/ the sign of x
+	- gelu(x) = x*PHI(x), the normal CDF PHI(x) = (1+erf(x/sqrt2))/2. for t=|x|/sqrt2 < 0.5, erf(t) = t*P(t^2). past it, erfc(t) = exp(-t^2)*G(1/(1+t/2)) (a degree-9 fit of erfc(t)*exp(t^2) on [0.5..10]), and x^2/2 is split in an exact high part and a small low part (exp(-lo) a degree-4 polynomial), since exp(-t^2) amplifies any rounding of t^2 by t^2
+	- sigmoid(x) = 1/(1+e) for x>=0, e/(1+e) for x<0, w/ e = exp(-|x|), so neither tail overflows or cancels. silu and swish are x*sigmoid(b*x), and the x<0 side is (x*e)/(1+e)
+	- the derivatives come from z, not from f(z): sigmoid' = s*(1-s) w/ both factors computed as above, tanh' = 4e/(1+e)^2 w/ e = exp(-2|x|), so they don't cancel near saturation
+max error against a double-precision reference, over every 61st float (70M inputs), in ulp where the result is normal:
+	- exp 1.0, sigmoid 2.7, tanh 1.5, gelu 5.6, silu 3.6 (for |y| >= 2^-120; below it exp(x) itself is subnormal), swish (b=1.5) 65, at x=-44: exp(-b*x) amplifies the rounding of b*x by |b*x|
+	- the derivatives, absolute (they have roots, where no relative bound holds): sigmoid' 5.4e-8, tanh' 2.2e-7, silu' 1.9e-7, gelu' 1.4e-7, swish' 1.9e-7. identity and relu are exact
+the kernels are also text: fp_src() compiles its code and keeps a copy in a string, so code generators (ncc) can emit the very same kernels into self-contained C files. so no preprocessor directives or compound literals inside it, and no `//` comments (they'd vanish from the string). fp_srcput() prints such a string 1 statement per line. fp_src_act_f32 is a scalar fallback w/ the same API, on top of libm, for compilers w/o vector extensions (tcc): fp_src_else() compiles it exactly where fp_src() doesn't, so f32_act() & co. always exist
+*/
+#if defined(__GNUC__) && !defined(__TINYC__)
+#define fp_src(     NAME, ...)  __VA_ARGS__  __attribute__((unused)) static const char NAME[] = #__VA_ARGS__;
+#define fp_src_else(NAME, ...)               __attribute__((unused)) static const char NAME[] = #__VA_ARGS__;
+#else
+#include <math.h>  // the scalar fallback is compiled here
+#define fp_src(     NAME, ...)               __attribute__((unused)) static const char NAME[] = #__VA_ARGS__;
+#define fp_src_else(NAME, ...)  __VA_ARGS__  __attribute__((unused)) static const char NAME[] = #__VA_ARGS__;
+#endif
+
+fp_src(fp_src_act,
+typedef float f32x16 __attribute__((vector_size(64)));
+typedef int   i32x16 __attribute__((vector_size(64)));
+
+static inline void f32x16_sel(f32x16* x, const i32x16* m, const f32x16* a){
+	*x = (f32x16)(((i32x16)*a & *m) | ((i32x16)*x & ~*m));
+}
+
+static inline void f32x16_exp(f32x16* x){
+	f32x16 v=*x, zero={0}, lo=zero-103.972076f, hi=zero+88.7228394f, inf=zero+__builtin_inff();
+	i32x16 mlo=v<lo, mhi=v>hi;
+	f32x16_sel(&v,&mlo,&lo);
+	f32x16_sel(&v,&mhi,&hi);
+	f32x16 t = v*1.44269504f;
+	i32x16 ki = __builtin_convertvector(t + (f32x16)(((i32x16)t & (-2147483647-1)) | 0x3f000000), i32x16);
+	f32x16 k = __builtin_convertvector(ki, f32x16);
+	f32x16 r = (v - k*0.693359375f) - k*-2.12194440e-4f;
+	f32x16 p = ((((1.9875691500e-4f*r + 1.3981999507e-3f)*r + 8.3334519073e-3f)*r + 4.1665795894e-2f)*r + 1.6666665459e-1f)*r + 5.0000001201e-1f;
+	i32x16 k0 = ki>>1;
+	p = (p*r*r + r + 1.0f) * (f32x16)((k0+127)<<23);
+	p = p * (f32x16)((ki-k0+127)<<23);
+	f32x16_sel(&p,&mlo,&zero);
+	f32x16_sel(&p,&mhi,&inf);
+	i32x16 mnan = v!=v;
+	f32x16_sel(&p,&mnan,&v);
+	*x = p;
+}
+
+static inline void f32x16_sig2(const f32x16* x, f32x16* s, f32x16* s1){
+	f32x16 e=(f32x16)((i32x16)*x | (-2147483647-1)), zero={0};
+	f32x16_exp(&e);
+	f32x16 q = 1.0f/(1.0f+e), r = e*q;
+	i32x16 m = *x<zero;
+	*s=q;  *s1=r;
+	f32x16_sel(s,&m,&r);
+	f32x16_sel(s1,&m,&q);
+}
+
+static inline void f32x16_sigmoid(f32x16* x){
+	f32x16 s1;
+	f32x16_sig2(x,x,&s1);
+}
+
+static inline void f32x16_swish(f32x16* x, float b){
+	f32x16 v=*x, y=b*v, e=(f32x16)((i32x16)y | (-2147483647-1)), zero={0};
+	f32x16_exp(&e);
+	f32x16 q = 1.0f/(1.0f+e), p = v*q, n = (v*e)*q;
+	i32x16 m = y<zero;
+	f32x16_sel(&p,&m,&n);
+	*x = p;
+}
+
+static inline void f32x16_dswish(f32x16* g, const f32x16* z, float b){
+	f32x16 y=b * *z, s, s1, zero={0};
+	f32x16_sig2(&y,&s,&s1);
+	f32x16 t = s*s1, d = y*t;
+	i32x16 m = t==zero;
+	f32x16_sel(&d,&m,&zero);
+	*g *= s + d;
+}
+
+static inline void f32x16_tanh(f32x16* x){
+	f32x16 v=*x, a=(f32x16)((i32x16)v & 0x7fffffff), z=v*v;
+	f32x16 p = ((((-5.70498872745e-3f*z + 2.06390887954e-2f)*z - 5.37397155531e-2f)*z + 1.33314422036e-1f)*z - 3.33332819422e-1f)*z*v + v;
+	f32x16 e = -2.0f*a;
+	f32x16_exp(&e);
+	f32x16 q = (1.0f-e)/(1.0f+e);
+	q = (f32x16)((i32x16)q | ((i32x16)v & (-2147483647-1)));
+	i32x16 m = a<0.625f;
+	f32x16_sel(&q,&m,&p);
+	*x = q;
+}
+
+static inline void f32x16_erf2(const f32x16* x, f32x16* e, f32x16* g, f32x16* c){
+	f32x16 zero={0}, cap=zero+14.5f, a=(f32x16)((i32x16)*x & 0x7fffffff), t=a*0.707106781f, s=t*t;
+	*e = t*((((4.728139993e-3f*s - 2.676265949e-2f)*s + 1.128291895e-1f)*s - 3.761261450e-1f)*s + 1.128379166f);
+	i32x16 mcap = a>cap;
+	f32x16_sel(&a,&mcap,&cap);
+	f32x16_sel(&t,&mcap,&cap);
+	f32x16 ah = (f32x16)((i32x16)a & -4096), lo = 0.5f*(a-ah)*(ah+a);
+	*g = -0.5f*ah*ah;
+	f32x16_exp(g);
+	*g = *g + *g*(lo*(((4.16666667e-2f*lo - 1.66666667e-1f)*lo + 0.5f)*lo - 1.0f));
+	f32x16 u = 1.0f/(1.0f + 0.5f*t);
+	*c = ((((((((-7.485286227e-2f*u + 3.530077456e-1f)*u - 6.140424744e-1f)*u + 4.094441821e-1f)*u - 1.100582710e-1f)*u + 2.362295683e-1f)*u + 2.346024951e-1f)*u + 2.836802881e-1f)*u + 2.819766386e-1f)*u + 3.848345820e-6f;
+}
+
+static inline void f32x16_ncdf(f32x16* x){
+	f32x16 v=*x, zero={0}, e, g, c;
+	f32x16_erf2(x,&e,&g,&c);
+	c = 0.5f*(g*c);
+	i32x16 mneg=v<zero, msmall=v*v<0.5f;
+	f32x16 q = 1.0f-c, qs = 0.5f+0.5f*e, ns = 0.5f-0.5f*e;
+	f32x16_sel(&q,&mneg,&c);
+	f32x16_sel(&qs,&mneg,&ns);
+	f32x16_sel(&q,&msmall,&qs);
+	*x = q;
+}
+
+static inline void f32x16_gelu(f32x16* x){
+	f32x16 v=*x, zero={0}, e, g, c;
+	f32x16_erf2(x,&e,&g,&c);
+	f32x16 q = v - v*(0.5f*(g*c)), qn = (v*g)*(0.5f*c), qs = v*(0.5f+0.5f*e), ns = v*(0.5f-0.5f*e);
+	i32x16 mneg=v<zero, msmall=v*v<0.5f, mfar = v < -14.5f;
+	f32x16_sel(&q,&mneg,&qn);
+	f32x16_sel(&qs,&mneg,&ns);
+	f32x16_sel(&q,&msmall,&qs);
+	f32x16_sel(&q,&mfar,&zero);
+	*x = q;
+}
+
+static inline void f32x16_act(int f, float b, f32x16* x){
+	f32x16 zero={0};
+	i32x16 m;
+	switch(f){
+		case 1:  f32x16_sigmoid(x);  break;
+		case 2:  f32x16_tanh(x);  break;
+		case 3:  m = *x<zero;  f32x16_sel(x,&m,&zero);  break;
+		case 4:  f32x16_swish(x,1.0f);  break;
+		case 5:  f32x16_gelu(x);  break;
+		case 6:  f32x16_swish(x,b);  break;
+	}
+}
+
+static inline void f32x16_dact(int f, float b, f32x16* g, const f32x16* z){
+	f32x16 zero={0}, one=zero+1.0f, s, s1, d, e, c;
+	i32x16 m;
+	switch(f){
+		case 1:  f32x16_sig2(z,&s,&s1);  *g *= s*s1;  break;
+		case 2:  e = -2.0f*(f32x16)((i32x16)*z & 0x7fffffff);  f32x16_exp(&e);  s = 1.0f/(1.0f+e);  *g *= 4.0f*e*s*s;  break;
+		case 3:  m = zero<*z;  d = (f32x16)(m & (i32x16)one);  *g *= d;  break;
+		case 4:  f32x16_dswish(g,z,1.0f);  break;
+		case 5:  s = *z;  f32x16_ncdf(&s);  f32x16_erf2(z,&e,&d,&c);  d = s + *z*(0.398942280f*d);  m = 14.5f < (f32x16)((i32x16)*z & 0x7fffffff);  e = (f32x16)((zero<*z) & (i32x16)one);  f32x16_sel(&d,&m,&e);  *g *= d;  break;
+		case 6:  f32x16_dswish(g,z,b);  break;
+	}
+}
+
+static inline void f32_act(int f, float b, long m, float* y, const float* z){
+	long i=0;
+	for(; i+16<=m; i+=16){
+		f32x16 v;
+		__builtin_memcpy(&v, z+i, sizeof(v));
+		f32x16_act(f,b,&v);
+		__builtin_memcpy(y+i, &v, sizeof(v));
+	}
+	if(i<m){
+		f32x16 v={0};
+		__builtin_memcpy(&v, z+i, sizeof(float)*(m-i));
+		f32x16_act(f,b,&v);
+		__builtin_memcpy(y+i, &v, sizeof(float)*(m-i));
+	}
+}
+
+static inline void f32_dact(int f, float b, long m, float* g, const float* z){
+	long i=0;
+	for(; i+16<=m; i+=16){
+		f32x16 vg, vz;
+		__builtin_memcpy(&vg, g+i, sizeof(vg));
+		__builtin_memcpy(&vz, z+i, sizeof(vz));
+		f32x16_dact(f,b,&vg,&vz);
+		__builtin_memcpy(g+i, &vg, sizeof(vg));
+	}
+	if(i<m){
+		f32x16 vg={0}, vz={0};
+		__builtin_memcpy(&vg, g+i, sizeof(float)*(m-i));
+		__builtin_memcpy(&vz, z+i, sizeof(float)*(m-i));
+		f32x16_dact(f,b,&vg,&vz);
+		__builtin_memcpy(g+i, &vg, sizeof(float)*(m-i));
+	}
+}
+
+static inline float f32_act1(int f, float b, float z){
+	f32x16 v={z};
+	f32x16_act(f,b,&v);
+	return v[0];
+}
+
+static inline float f32_dact1(int f, float b, float z){
+	f32x16 g={1.0f}, vz={z};
+	f32x16_dact(f,b,&g,&vz);
+	return g[0];
+}
+)
+
+fp_src_else(fp_src_act_f32,
+static inline float f32_act1(int f, float b, float z){
+	switch(f){
+		case 1:  return 1.0f/(1.0f+expf(-z));
+		case 2:  return tanhf(z);
+		case 3:  return z<0.0f ? 0.0f : z;
+		case 4:  return z/(1.0f+expf(-z));
+		case 5:  return 0.5f*z*(1.0f+erff(0.70710678f*z));
+		case 6:  return z/(1.0f+expf(-b*z));
+	}
+	return z;
+}
+
+static inline float f32_dact1(int f, float b, float z){
+	float s;
+	switch(f){
+		case 1:  s = 1.0f/(1.0f+expf(-z));  return s*(1.0f-s);
+		case 2:  s = tanhf(z);  return 1.0f-s*s;
+		case 3:  return 0.0f<z ? 1.0f : 0.0f;
+		case 4:  s = 1.0f/(1.0f+expf(-z));  return s*(1.0f+z*(1.0f-s));
+		case 5:  return 0.5f*(1.0f+erff(0.70710678f*z)) + 0.39894228f*z*expf(-0.5f*z*z);
+		case 6:  s = 1.0f/(1.0f+expf(-b*z));  return s*(1.0f+b*z*(1.0f-s));
+	}
+	return 1.0f;
+}
+
+static inline void f32_act(int f, float b, long m, float* y, const float* z){
+	for(long i=0; i<m; ++i)  y[i] = f32_act1(f,b,z[i]);
+}
+
+static inline void f32_dact(int f, float b, long m, float* g, const float* z){
+	for(long i=0; i<m; ++i)  g[i] *= f32_dact1(f,b,z[i]);
+}
+)
+
+// @meta  print the C code @src, as stringified by fp_src(), 1 statement per line: a `{` opens a block iff it follows a `)`, an `else` or a `do` (else it's an initializer, and it stays inline), and a `;` ends a statement iff it's outside parentheses
+fdef void fp_srcput(FILE* fp, const char* src){
+	u8  blk[0x40];  // blk[k] is 1 if the k-th open brace is a block
+	int nb=0, depth=0, par=0, bol=1;
+	for(const char* c=src; *c!=0x00; ++c){
+		if(bol && *c==0x20)  continue;
+		if(*c==0x7d && 0<nb && blk[--nb]){  // } of a block
+			--depth;
+			if(!bol)  fputc(0x0a,fp);
+			for(int i=0; i<depth; ++i)  fputc(0x09,fp);
+			fputs(depth==0 ? "}\n\n" : "}\n", fp);  bol=1;
+			continue;
+		}
+		if(bol)  for(int i=0; i<depth; ++i)  fputc(0x09,fp);
+		bol=0;
+		fputc(*c,fp);
+		if(     *c==0x28)  ++par;  // (
+		else if(*c==0x29)  --par;  // )
+		else if(*c==0x3b && par==0){  fputs(depth==0 ? "\n\n" : "\n", fp);  bol=1;  }  // ;
+		else if(*c==0x7b){  // {
+			const char* p=c-1;  while(src<p && *p==0x20)  --p;
+			int isblk = *p==0x29 || (src+3<=p && memcmp(p-3,"else",4)==0) || (src+1<=p && memcmp(p-1,"do",2)==0);
+			if(nb<(int)sizeof(blk))  blk[nb++]=isblk;
+			if(isblk){  ++depth;  fputc(0x0a,fp);  bol=1;  }
+		}
+	}
+}
+
 // ----------------------------------------------------------------------------------------------------------------------------# @blk1  libzstd  -l:libzstd.a
 #if defined(M_ZSTD)
 /*
@@ -2836,7 +3180,7 @@ int main(){  setlocale(LC_NUMERIC,"");
 #include <zstd.h>  // #define ZSTD_STATIC_LINKING_ONLY  // ZSTD_findDecompressedSize
 #define ZSTD_LEVEL  3  // For @ZSTD_compress()
 
-buf_t zcompress(i64 d_bdim,void* d_data){  // Compress mem-to-mem (Pareto-efficient)
+fdef buf_t zcompress(i64 d_bdim,void* d_data){  // Compress mem-to-mem (Pareto-efficient)
 	buf_t buf = bini(ZSTD_compressBound(d_bdim));  // We allocate a lot more data than we'll (most likely) need
 
 	// ZSTD_fast ZSTD_dfast ZSTD_greedy ZSTD_lazy ZSTD_lazy2 ZSTD_btlazy2 ZSTD_btopt ZSTD_btultra ZSTD_btultra2  // from faster to stronger
@@ -2850,7 +3194,6 @@ buf_t zcompress(i64 d_bdim,void* d_data){  // Compress mem-to-mem (Pareto-effici
 	ZSTD_CCtx_setParameter(ctx, ZSTD_c_strategy,        ZSTD_fast);
 	ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel,1);  // Set one compression param, selected w/ ZSTD_cParameter. All params have valid bounds, which are queried w/ ZSTD_cParam_getBounds(). Providing a value beyond the bound will clamp it or trigger an error (depending on param). Setting a param is generally only possible during frame initialization (before starting compression).
 	buf.bdim = ZSTD_compress2(ctx, buf.data,buf.bdim, d_data,d_bdim);  // Compression parameters are pushed into CCtx before starting compression w/ ZSTD_CCtx_set*() 
-	buf.idim = buf.bdim;
 	ZSTD_freeCCtx(ctx);
 	return buf;
 }
@@ -2905,9 +3248,65 @@ fdef void zdecompress_path2path(char* c_path){  // Decompress path-to-path
 fdef buf_t zcompress2(i64 d_bdim,void* d_data){  // Compress mem-to-mem (Pareto-inefficient?)
 	buf_t buf = bini(ZSTD_compressBound(d_bdim));  // We allocate a lot more data than we'll (most likely) need
 	buf.bdim  = ZSTD_compress(buf.data,buf.bdim, d_data,d_bdim, ZSTD_LEVEL);  if(ZSTD_isError(buf.bdim)) fail();
-	buf.idim  = buf.bdim;
 	return buf;
 }
+
+// ----------------------------------------------------------------  streaming decompression, path-to-window: the decompressed data only ever exists 1 window at a time, so it needn't fit in mem (nor does its size need to be in the frame header)
+/*
+zstream_t zs = zstream_ini("/home/da/dl/02.ppm.zst", 0x100000);
+for(i64 keep=0; zstream_next(&zs,keep); ){
+	// do stuff with @zs.data[0 .. zs.idim), and set @keep to the number of bytes at the end of the window that must come back at the start of the next window (eg. a partial line). once @zs.eof is set, this is the last window, so keep nothing
+}
+zstream_end(&zs);
+*/
+tdef{
+	file_t        file;  // the compressed file, mmapped
+	ZSTD_DCtx*    ctx;
+	ZSTD_inBuffer in;
+	i64           bdim;  // window capacity, in bytes. only grows if the caller keeps a whole window
+	i64           idim;  // window size, in bytes
+	u8*           data;  // window, followed by a 0x00
+	i64           pos;   // number of decompressed bytes before the window
+	int           eof;   // the compressed file is fully consumed, and the decoder is fully flushed
+	size_t        ret;   // the last return value of ZSTD_decompressStream(): 0 iff the last frame is complete
+}zstream_t;
+
+fdef zstream_t zstream_ini(char* path, i64 bdim){
+	zstream_t zs = {0x00};
+	zs.file = file_ini(path);
+	zs.ctx  = ZSTD_createDCtx();
+	zs.in   = (ZSTD_inBuffer){src:zs.file.data, size:zs.file.bdim, pos:0};
+	zs.bdim = mmax(bdim, ZSTD_DStreamOutSize());
+	zs.data = malloc(zs.bdim+1);
+	return zs;
+}
+fdef void zstream_end(zstream_t* zs){
+	if(zs==NULL) return;
+	ZSTD_freeDCtx(zs->ctx);
+	file_end(&zs->file);
+	free(zs->data);
+	*zs=(zstream_t){0x00};
+}
+
+// @meta  move the last @keep bytes of the window to its start, and decompress into the rest of it. if @keep is the whole window, the window doubles first
+// @ret  the window size, which is @keep (or less) only at the end of the data. a corrupt or truncated file is fatal
+fdef i64 zstream_next(zstream_t* zs, i64 keep){
+	keep = mmin(mmax(keep,0), zs->idim);
+	zs->pos += zs->idim - keep;
+	memmove(zs->data, zs->data + zs->idim - keep, keep);
+	zs->idim = keep;
+	if(keep==zs->bdim){  zs->bdim *= 2;  zs->data = realloc(zs->data, zs->bdim+1);  }
+	while(!zs->eof && zs->idim<zs->bdim){
+		ZSTD_outBuffer out = {dst:zs->data+zs->idim, size:zs->bdim-zs->idim, pos:0};
+		zs->ret = ZSTD_decompressStream(zs->ctx, &out,&zs->in);
+		if(ZSTD_isError(zs->ret)){  printf("\x1b[91mFAIL  \x1b[92m%s  \x1b[0m%s  \x1b[33m%s\x1b[0m\n", __func__, zs->file.path, ZSTD_getErrorName(zs->ret));  exit(1);  }
+		zs->idim += out.pos;
+		zs->eof   = zs->in.pos==zs->in.size && out.pos<out.size;  // if the decoder didn't fill the window, it has flushed all it has
+	}
+	if(zs->eof && zs->ret!=0){  printf("\x1b[91mFAIL  \x1b[92m%s  \x1b[0m%s  \x1b[33mtruncated frame\x1b[0m\n", __func__, zs->file.path);  exit(1);  }
+	zs->data[zs->idim] = 0x00;  // like a C string, so parsers can peek 1 byte past the window
+	return zs->idim;
+}
 #endif  // M_ZSTD
 
 // ----------------------------------------------------------------------------------------------------------------------------#
@@ -19,125 +19,264 @@ cp $mathisart/mathisart4.h .
 	5: gelu
 	6: swish
 
+- a .nal.zst (or .nam.zst) is a .nal (or .nam), zstd-compressed. it's decompressed 1 window at a time, so it never has to fit in mem. see @blk1 zst
+
+# .nel file format spec
+
+- 1 .nel file encodes 1 neural net as a list of edges, 1 per line, in any order: `i j [fj]`, in hex, like a NAL. see @blk1 nel
+- the N line is optional
+
+# .nad file format spec
+
+- 1 .nad file encodes 1 neural net, declared layer by layer (in, dense, conv, dwconv, add, rnn) instead of neuron by neuron. see @blk1 nad
+- all numbers are decimal, and activation fns can also be given by name
+- a .nad is expanded straight into the graph IR, so the neuron-by-neuron NAL/NAM text never exists
+
 def nlogits(p,q):  # @meta  the number of trials for an event of proba q to have proba p of at least 1 occurrence  # @eg  nlogits(1/2, 1/2)  # @eg  nlogits(0.99, 1/10)
 	return m.log(1-p)/m.log(1-q)
 */
 #include <mathisart4.h>
+#include <pthread.h>
 
 #define NALPATH "nn00.nal"
 #define NAMPATH "nn00.nam"
 
+#define NIRP_CHUNK_BDIM_MIN  0x100000  // NAL parse: the smallest chunk worth its own thread
+#if !defined(NIRP_SIMD)
+#define NIRP_SIMD            __avx2__  // NAL parse: decode in-index lists 32 bytes at a time. -DNIRP_SIMD=0 for the scalar parser
+#endif
+#if !defined(NAMP_SIMD)
+#define NAMP_SIMD            __avx2__  // NAM parse: turn rows into bit-packed row words 32 characters at a time. -DNAMP_SIMD=0 for the scalar parser
+#endif
+
 #define OPADD    0xffffffff
 #define OPMUL    0xfffffffe
 
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  output
+/*
+by default ncc prints 1 summary line (w/ timings) and nothing else. -q prints nothing but errors. -v turns on diagnostics: the tutorial, the per-token parse trace, and the F/I/O/NAM tables
+diagnostics are opt-in because they're O[N+E] lines for NALs and O[N^2] for NAMs, and they go to @nnlog, a fully-buffered stream, so they cost no syscall per token and never interleave w/ @print()
+*/
+#define NCC_QUIET    0
+#define NCC_SUMMARY  1
+#define NCC_VERBOSE  2
+int   ncc_lvl = NCC_SUMMARY;
+FILE* nnlog   = NULL;
+
+#define nnverbose()  (NCC_VERBOSE<=ncc_lvl)
+#define nnlogf(...)  do{  if(nnverbose()) fprintf(nnlog, __VA_ARGS__);  }while(0)
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nir: the graph IR, in compressed sparse row (CSR) form
+/*
+the in -indices of neuron nj are Iidx[Ioff[j] .. Ioff[j+1]), in NAL order. the position e of an in-index in Iidx is the index of the edge (ie. weight) wij
+the out-indices of neuron nj are Oidx[Ooff[j] .. Ooff[j+1]), in ascending order. the out-CSR is the transpose of the in-CSR
+*/
+tdef{
+	i64  N;     // number of neurons
+	i64  E;     // number of edges
+	u8*  F;     // vec of activation fn codes, [N]
+	u64* Ioff;  // vec of in -CSR offsets, [N+1]
+	u32* Iidx;  // vec of in -CSR indices, [E]
+	u64* Ooff;  // vec of out-CSR offsets, [N+1]
+	u32* Oidx;  // vec of out-CSR indices, [E]
+	file_t nab;  // if nab.data is not NULL, the arrays above aren't vecs: they live (in place) in this mmapped .nab file
+}nir_t;
+
+#define nir_idim(NIR,J)  ((NIR)->Ioff[(J)+1] - (NIR)->Ioff[(J)])  // @meta  in -degree of neuron nj
+#define nir_odim(NIR,J)  ((NIR)->Ooff[(J)+1] - (NIR)->Ooff[(J)])  // @meta  out-degree of neuron nj
+
+fdef void nir_end(nir_t* nir){
+	if(nir==NULL) return;
+	if(nir->nab.data!=NULL){  file_end(&nir->nab);  *nir=(nir_t){0x00};  return;  }
+	if(nir->F   !=NULL) vend(nir->F);
+	if(nir->Ioff!=NULL) vend(nir->Ioff);
+	if(nir->Iidx!=NULL) vend(nir->Iidx);
+	if(nir->Ooff!=NULL) vend(nir->Ooff);
+	if(nir->Oidx!=NULL) vend(nir->Oidx);
+	*nir=(nir_t){0x00};
+}
+
+// @meta  O[V+E] CSR transpose via a counting sort: the rows of the output are in ascending order. @toff must have room for N+1 items, @tidx for E items
+fdef void nir_transpose(i64 N,i64 E, u64* off,u32* idx, u64* toff,u32* tidx){
+	memset(toff,0x00,Bsize(u64)*(N+1));
+	mfor(e,0,E)  ++toff[idx[e]+1];
+	mfor(j,0,N)  toff[j+1] += toff[j];
+	u64* pos = malloc(Bsize(u64)*mmax(N,1));  memcpy(pos,toff,Bsize(u64)*N);
+	mfor(j,0,N)
+		for(u64 e=off[j]; e<off[j+1]; ++e)  tidx[pos[idx[e]]++] = j;
+	free(pos);
+}
+
+// @meta  derive the out-CSR from the in-CSR
+fdef void nir_otranspose(nir_t* nir){
+	nir->Ooff = vini1(u64,nir->N+1);  vidim(nir->Ooff) = nir->N+1;
+	nir->Oidx = vini1(u32,nir->E+1);  vidim(nir->Oidx) = nir->E;
+	nir_transpose(nir->N,nir->E, nir->Ioff,nir->Iidx, nir->Ooff,nir->Oidx);
+}
+
+// @meta  derive the in-CSR from the out-CSR
+fdef void nir_itranspose(nir_t* nir){
+	nir->Ioff = vini1(u64,nir->N+1);  vidim(nir->Ioff) = nir->N+1;
+	nir->Iidx = vini1(u32,nir->E+1);  vidim(nir->Iidx) = nir->E;
+	nir_transpose(nir->N,nir->E, nir->Ooff,nir->Oidx, nir->Ioff,nir->Iidx);
+}
+
 // ----------------------------------------------------------------------------------------------------------------------------# @blk1
 /*
 DLY/Dnj = SUM[y,, DLY/DLy * DLy/DLyz * SUM[k,Oj, DLyz/nk]]
 */
 fdef void nntut(){  // nj = fj[SUM[i,Ij, ni*wij]]  // THE VALUE OF EACH NEURON nj IS ALWAYS ALWAYS A SIMPLE DOT PRODUCT
-	sep();
-	print("\x1b[92m%c\x1b[0m\n", __func__);
-	print("\x1b[91m- \x1b[0mn\x1b[32mj       \x1b[0m\x1b[91m= \x1b[35mf\x1b[32mj\x1b[91m[\x1b[35mSUM\x1b[91m[\x1b[31mi\x1b[91m,\x1b[92mI\x1b[32mj\x1b[91m, \x1b[0mn\x1b[31mi\x1b[91m*\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]]\x1b[0m\n");
-	print("\x1b[91m- \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m=    \x1b[35mSUM\x1b[91m[\x1b[34mk\x1b[91m,\x1b[92mO\x1b[32mj\x1b[91m, \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]\x1b[0m\n");
-	print("\x1b[91m- \x1b[0mfwd-prop: the \x1b[91mVALUE                  \x1b[0mn\x1b[32mj       \x1b[0mof each \x1b[91mNEURON            \x1b[0mn\x1b[32mj  \x1b[0mis ALWAYS a DOT PRODUCT (and \x1b[35mf\x1b[32mj\x1b[91m[]\x1b[0m) over \x1b[91mNEURON IN -CONECTIONS \x1b[91m{\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m} \x1b[0mfor \x1b[91mIN -NEURONS \x1b[91m{\x1b[0mn\x1b[31mi\x1b[91m} \x1b[92minto   \x1b[0mn\x1b[32mj\x1b[0m\n");
-	print("\x1b[91m- \x1b[0mbwd-prop: the \x1b[91mLOSS-WEIGHT DERIVATIVE \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31mi\x1b[32mj \x1b[0mof each \x1b[91mNEURON CONNECTION \x1b[0mw\x1b[31mi\x1b[32mj \x1b[0mis ALWAYS a DOT PRODUCT            over \x1b[91mNEURON OUT-CONECTIONS \x1b[91m{\x1b[0mw\x1b[32mj\x1b[34mk\x1b[91m} \x1b[0mfor \x1b[91mOUT-NEURONS \x1b[91m{\x1b[0mn\x1b[34mk\x1b[91m} \x1b[92mout of \x1b[0mn\x1b[32mj\x1b[0m\n");
-	print("\x1b[91m- \x1b[0meach \x1b[92mI\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[31mi\x1b[91m} \x1b[0mfor \x1b[91mIN -NEURONS \x1b[91m{\x1b[0mn\x1b[31mi\x1b[91m} \x1b[92minto   \x1b[0mn\x1b[32mj\x1b[0m. eg. if \x1b[92mI\x1b[32m4 \x1b[0mis \x1b[91m{\x1b[31m0\x1b[91m,\x1b[31m1\x1b[91m}\x1b[0m, then n\x1b[31m0\x1b[0m,n\x1b[31m1 \x1b[0mgo   \x1b[92minto   \x1b[0mn\x1b[32m4\x1b[0m. n\x1b[31m0\x1b[0m,n\x1b[31m1 \x1b[0mcan simultaneously go   \x1b[92minto   \x1b[0mother neurons, say n\x1b[32m5\x1b[0m\n");
-	print("\x1b[91m- \x1b[0meach \x1b[92mO\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[34mk\x1b[91m} \x1b[0mfor \x1b[91mOUT-NEURONS \x1b[91m{\x1b[0mn\x1b[34mk\x1b[91m} \x1b[92mout of \x1b[0mn\x1b[32mj\x1b[0m. eg. if \x1b[92mO\x1b[32m0 \x1b[0mis \x1b[91m{\x1b[34m4\x1b[91m,\x1b[34m5\x1b[91m}\x1b[0m, then n\x1b[34m4\x1b[0m,n\x1b[34m5 \x1b[0mcome \x1b[92mout of \x1b[0mn\x1b[32m0\x1b[0m. n\x1b[34m4\x1b[0m,n\x1b[34m5 \x1b[0mcan simultaneously come \x1b[92mout of \x1b[0mother neurons, say n\x1b[32m1\x1b[0m\n");
-	print("\x1b[91m- \x1b[0meach factor in the summand \x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj \x1b[0min the dot product \x1b[35mSUM\x1b[91m[\x1b[34mk\x1b[91m,\x1b[92mO\x1b[32mj\x1b[91m, \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m] \x1b[0mtriggers \x1b[35mO\x1b[91m[\x1b[92mN\x1b[91m^\x1b[0m2\x1b[91m] \x1b[0mproducts? but there are many repeated computations: this is backpropagation\n");
-	putchar(0x0a);
-	print("\x1b[91m- \x1b[0ma \x1b[91mneural net \x1b[0mis a \x1b[91mdirected graph\x1b[0m, where the \x1b[91mvertices \x1b[0mare \x1b[91mneurons \x1b[0mand the \x1b[91medges \x1b[0mare \x1b[91mneuron connections\x1b[0m\n");
-	print("\x1b[91m- \x1b[0mthe \x1b[91mneuron connections \x1b[0mare the so-called \x1b[91mweights\x1b[0m\n");
-	putchar(0x0a);
-	print("\x1b[91m- \x1b[92mN                       \x1b[0mis the set of all INTEGERS in \x1b[91m[\x1b[0m0\x1b[91m..\x1b[92mN\x1b[91m)\x1b[0m, and also the number of \x1b[91mNEURONS\x1b[0m\n");
-	print("\x1b[91m- \x1b[91m{\x1b[00mn\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all \x1b[91mNEURONS\x1b[0m\n");
-	print("\x1b[91m- \x1b[91m{\x1b[35mf\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all \x1b[91mNEURON ACTIVATION FNS\x1b[0m\n");
-	print("\x1b[91m- \x1b[91m{\x1b[92mI\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all sets of \x1b[91mNEURON IN -CONNECTION INDICES\x1b[0m, where each \x1b[92mI\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[31mi\x1b[91m} \x1b[0mfor \x1b[91mIN -NEURONS \x1b[91m{\x1b[0mn\x1b[31mi\x1b[91m} \x1b[92minto   \x1b[0mn\x1b[32mj\x1b[0m. used during fwd-prop\x1b[0m\n");
-	print("\x1b[91m- \x1b[91m{\x1b[92mO\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all sets of \x1b[91mNEURON OUT-CONNECTION INDICES\x1b[0m, where each \x1b[92mO\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[34mk\x1b[91m} \x1b[0mfor \x1b[91mOUT-NEURONS \x1b[91m{\x1b[0mn\x1b[34mk\x1b[91m} \x1b[92mout of \x1b[0mn\x1b[32mj\x1b[0m. used during bwd-prop\x1b[0m\n");
-	print("\x1b[91m- \x1b[91m{\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[31mi \x1b[91min \x1b[92mI\x1b[32mj\x1b[91m} \x1b[0mis the set of all \x1b[91mNEURON IN -CONNECTIONS \x1b[0mfrom neuron n\x1b[31mi \x1b[0mto neuron n\x1b[32mj \x1b[0m(aka. synapses, weights, parameters)\n");
-	print("\x1b[91m- \x1b[91m{\x1b[0mw\x1b[32mj\x1b[34mk \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[34mk \x1b[91min \x1b[92mO\x1b[34mk\x1b[91m} \x1b[0mis the set of all \x1b[91mNEURON OUT-CONNECTIONS \x1b[0mfrom neuron n\x1b[32mj \x1b[0mto neuron n\x1b[34mk \x1b[0m(aka. synapses, weights, parameters)\n");
-	print("\x1b[91m- \x1b[91m{\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[31mi \x1b[91min \x1b[92mI\x1b[32mj\x1b[91m} \x1b[0mand \x1b[91m{\x1b[0mw\x1b[32mj\x1b[34mk \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[34mk \x1b[91min \x1b[92mO\x1b[34mk\x1b[91m} \x1b[0mare isomorphic\n");
-	print("\x1b[91m- \x1b[91m{\x1b[92mI\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m} \x1b[0mand \x1b[91m{\x1b[92mO\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m} \x1b[0mare isomorphic, via graph ops. complexity may be \x1b[35mO\x1b[91m[\x1b[0mV\x1b[91m^\x1b[0m2\x1b[91m] \x1b[0mw/ a hash table for each index set \x1b[92mI\x1b[32mj\x1b[0m/\x1b[92mO\x1b[32mj\x1b[0m, or \x1b[35mO\x1b[91m[\x1b[0mV\x1b[91m^\x1b[0m2\x1b[91m*\x1b[0mE\x1b[91m] \x1b[0mw/ an array for each index set \x1b[92mI\x1b[32mj\x1b[0m/\x1b[92mO\x1b[32mj\x1b[0m\n");
-	print("\x1b[91m- \x1b[0mto FULLY SPECIFY (the topology/connectivity of) a net (feedforward-only like fc/conv/recurrent nets, or feedforward/feedback like deep boltzmann machines).\n");
-	print("  it suffices to SPECIFY \x1b[92mN\x1b[0m, \x1b[35mf\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m, and \x1b[92mI\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m, OR\n");
-	print("  it suffices to SPECIFY \x1b[92mN\x1b[0m, \x1b[35mf\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m, and \x1b[92mO\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m.\n");
-	print("  this representation is called the \x1b[91mNAL \x1b[0m(neural adjacency list), because it encodes the (topology/connectivity of) the net via \x1b[92mN \x1b[0msets of indices.\n");
-	print("  example (\x1b[91mNAL\x1b[0m).\n");
-	print("    let \x1b[92mN \x1b[0mbe \x1b[34m0x\x1b[35m0e\x1b[0m. now:\n");
-	print("      \x1b[91m- \x1b[0mthe \x1b[32mj\x1b[0m-indices             are in \x1b[91m{ \x1b[32m0\x1b[0m, \x1b[32m1\x1b[0m, \x1b[32m2\x1b[0m, \x1b[32m3\x1b[0m, \x1b[32m4\x1b[0m, \x1b[32m5\x1b[0m, \x1b[32m6\x1b[0m, \x1b[32m7\x1b[0m, \x1b[32m8\x1b[0m, \x1b[32m9\x1b[0m, \x1b[32ma\x1b[0m, \x1b[32mb\x1b[0m, \x1b[32mc\x1b[0m, \x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
-	print("      \x1b[91m- \x1b[0mthe neurons n\x1b[32mj            \x1b[0mare in \x1b[91m{\x1b[0mn\x1b[32m0\x1b[0m,n\x1b[32m1\x1b[0m,n\x1b[32m2\x1b[0m,n\x1b[32m3\x1b[0m,n\x1b[32m4\x1b[0m,n\x1b[32m5\x1b[0m,n\x1b[32m6\x1b[0m,n\x1b[32m7\x1b[0m,n\x1b[32m8\x1b[0m,n\x1b[32m9\x1b[0m,n\x1b[32ma\x1b[0m,n\x1b[32mb\x1b[0m,n\x1b[32mc\x1b[0m,n\x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
-	print("      \x1b[91m- \x1b[0mthe activation fns \x1b[35mf\x1b[32mj     \x1b[0mare in \x1b[91m{\x1b[35mf\x1b[32m0\x1b[0m,\x1b[35mf\x1b[32m1\x1b[0m,\x1b[35mf\x1b[32m2\x1b[0m,\x1b[35mf\x1b[32m3\x1b[0m,\x1b[35mf\x1b[32m4\x1b[0m,\x1b[35mf\x1b[32m5\x1b[0m,\x1b[35mf\x1b[32m6\x1b[0m,\x1b[35mf\x1b[32m7\x1b[0m,\x1b[35mf\x1b[32m8\x1b[0m,\x1b[35mf\x1b[32m9\x1b[0m,\x1b[35mf\x1b[32ma\x1b[0m,\x1b[35mf\x1b[32mb\x1b[0m,\x1b[35mf\x1b[32mc\x1b[0m,\x1b[35mf\x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
-	print("      \x1b[91m- \x1b[0mthe sets of in-indices \x1b[92mI\x1b[32mj \x1b[0mare in \x1b[91m{\x1b[92mI\x1b[32m0\x1b[0m,\x1b[92mI\x1b[32m1\x1b[0m,\x1b[92mI\x1b[32m2\x1b[0m,\x1b[92mI\x1b[32m3\x1b[0m,\x1b[92mI\x1b[32m4\x1b[0m,\x1b[92mI\x1b[32m5\x1b[0m,\x1b[92mI\x1b[32m6\x1b[0m,\x1b[92mI\x1b[32m7\x1b[0m,\x1b[92mI\x1b[32m8\x1b[0m,\x1b[92mI\x1b[32m9\x1b[0m,\x1b[92mI\x1b[32ma\x1b[0m,\x1b[92mI\x1b[32mb\x1b[0m,\x1b[92mI\x1b[32mc\x1b[0m,\x1b[92mI\x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
-	print("    let \x1b[92mI\x1b[32m0 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m0 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
-	print("    let \x1b[92mI\x1b[32m1 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m1 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
-	print("    let \x1b[92mI\x1b[32m2 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m2 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
-	print("    let \x1b[92mI\x1b[32m3 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m3 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
-	print("    let \x1b[92mI\x1b[32m4 \x1b[0mbe \x1b[91m{\x1b[0m0\x1b[91m,\x1b[0m1\x1b[91m}\x1b[0m.     so n\x1b[32m4 \x1b[0mcomes from n\x1b[31m0\x1b[0m,n\x1b[31m1\x1b[0m.       layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32m5 \x1b[0mbe \x1b[91m{\x1b[0m0\x1b[91m,\x1b[0m1\x1b[91m,\x1b[0m2\x1b[91m}\x1b[0m.   so n\x1b[32m5 \x1b[0mcomes from n\x1b[31m0\x1b[0m,n\x1b[31m1\x1b[0m,n\x1b[31m2\x1b[0m.    layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32m6 \x1b[0mbe \x1b[91m{\x1b[0m1\x1b[91m,\x1b[0m2\x1b[91m,\x1b[0m3\x1b[91m}\x1b[0m.   so n\x1b[32m6 \x1b[0mcomes from n\x1b[31m1\x1b[0m,n\x1b[31m2\x1b[0m,n\x1b[31m3\x1b[0m.    layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32m7 \x1b[0mbe \x1b[91m{\x1b[0m2\x1b[91m,\x1b[0m3\x1b[91m}\x1b[0m.     so n\x1b[32m7 \x1b[0mcomes from n\x1b[31m2\x1b[0m,n\x1b[31m3\x1b[0m.       layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32m8 \x1b[0mbe \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m}\x1b[0m.     so n\x1b[32m8 \x1b[0mcomes from n\x1b[31m4\x1b[0m,n\x1b[31m5\x1b[0m.       layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32m9 \x1b[0mbe \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m}\x1b[0m.   so n\x1b[32m9 \x1b[0mcomes from n\x1b[31m4\x1b[0m,n\x1b[31m5\x1b[0m,n\x1b[31m6\x1b[0m.    layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32ma \x1b[0mbe \x1b[91m{\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.   so n\x1b[32ma \x1b[0mcomes from n\x1b[31m5\x1b[0m,n\x1b[31m6\x1b[0m,n\x1b[31m7\x1b[0m.    layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32mb \x1b[0mbe \x1b[91m{\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.     so n\x1b[32mb \x1b[0mcomes from n\x1b[31m6\x1b[0m,n\x1b[31m7\x1b[0m.       layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
-	print("    let \x1b[92mI\x1b[32mc \x1b[0mbe \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m. so n\x1b[32mc \x1b[0mcomes from n\x1b[31m8\x1b[0m,n\x1b[31m9\x1b[0m,n\x1b[31ma\x1b[0m,n\x1b[31mb\x1b[0m. layer \x1b[35m3\x1b[0m: length \x1b[35m3 \x1b[0mdependency chain (output neuron: no outputs)\n");
-	print("    let \x1b[92mI\x1b[32md \x1b[0mbe \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m. so n\x1b[32mc \x1b[0mcomes from n\x1b[31m8\x1b[0m,n\x1b[31m9\x1b[0m,n\x1b[31ma\x1b[0m,n\x1b[31mb\x1b[0m. layer \x1b[35m3\x1b[0m: length \x1b[35m3 \x1b[0mdependency chain (output neuron: no outputs)\n");
-	print("    now \x1b[92mO\x1b[32m0 \x1b[0mis \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m}\x1b[0m.     so n\x1b[32m0 \x1b[0mgoes  into n\x1b[34m4\x1b[0m,n\x1b[34m5\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m1 \x1b[0mis \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m}\x1b[0m.   so n\x1b[32m1 \x1b[0mgoes  into n\x1b[34m4\x1b[0m,n\x1b[34m5\x1b[0m,n\x1b[34m6\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m2 \x1b[0mis \x1b[91m{\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.   so n\x1b[32m2 \x1b[0mgoes  into n\x1b[34m5\x1b[0m,n\x1b[34m6\x1b[0m,n\x1b[34m7\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m3 \x1b[0mis \x1b[91m{\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.     so n\x1b[32m3 \x1b[0mgoes  into n\x1b[34m6\x1b[0m,n\x1b[34m7\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m4 \x1b[0mis \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m\x1b[91m}\x1b[0m.     so n\x1b[32m4 \x1b[0mgoes  into n\x1b[34m8\x1b[0m,n\x1b[34m9\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m5 \x1b[0mis \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m}\x1b[0m.   so n\x1b[32m5 \x1b[0mgoes  into n\x1b[34m8\x1b[0m,n\x1b[34m9\x1b[0m,n\x1b[34ma\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m6 \x1b[0mis \x1b[91m{\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m.   so n\x1b[32m6 \x1b[0mgoes  into n\x1b[34m9\x1b[0m,n\x1b[34ma\x1b[0m,n\x1b[34mb\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m7 \x1b[0mis \x1b[91m{\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m.     so n\x1b[32m7 \x1b[0mgoes  into n\x1b[34ma\x1b[0m,n\x1b[34mb\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m8 \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32m8 \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32m9 \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32m9 \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32ma \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32ma \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32mb \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32mb \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32mc \x1b[0mis \x1b[91m{\x1b[91m}\x1b[0m.        so n\x1b[32mc \x1b[0mgoes  into nothing\x1b[0m\n");
-	print("    now \x1b[92mO\x1b[32md \x1b[0mis \x1b[91m{\x1b[91m}\x1b[0m.        so n\x1b[32md \x1b[0mgoes  into nothing\x1b[0m\n");
-	print("    this specifies a net with: 4 inputs, a 4-neuron (sparsely-connected) hidden layer, a 4-neuron (sparsely-connected) hidden layer, and 2 outputs\n");
-	print("\x1b[91m- \x1b[0mthe \"number of layers\" is an implicit number given in the NAL/NAM, defined as the longest chain in a topological sort of the connectivity graph (implicitly) given by the NAL/NAM\n");
-}
-
-fdef void nirshow(){}
+	nnlogf("\n"M_SEP);
+	nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	nnlogf("\x1b[91m- \x1b[0mn\x1b[32mj       \x1b[0m\x1b[91m= \x1b[35mf\x1b[32mj\x1b[91m[\x1b[35mSUM\x1b[91m[\x1b[31mi\x1b[91m,\x1b[92mI\x1b[32mj\x1b[91m, \x1b[0mn\x1b[31mi\x1b[91m*\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]]\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m=    \x1b[35mSUM\x1b[91m[\x1b[34mk\x1b[91m,\x1b[92mO\x1b[32mj\x1b[91m, \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0mfwd-prop: the \x1b[91mVALUE                  \x1b[0mn\x1b[32mj       \x1b[0mof each \x1b[91mNEURON            \x1b[0mn\x1b[32mj  \x1b[0mis ALWAYS a DOT PRODUCT (and \x1b[35mf\x1b[32mj\x1b[91m[]\x1b[0m) over \x1b[91mNEURON IN -CONECTIONS \x1b[91m{\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m} \x1b[0mfor \x1b[91mIN -NEURONS \x1b[91m{\x1b[0mn\x1b[31mi\x1b[91m} \x1b[92minto   \x1b[0mn\x1b[32mj\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0mbwd-prop: the \x1b[91mLOSS-WEIGHT DERIVATIVE \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31mi\x1b[32mj \x1b[0mof each \x1b[91mNEURON CONNECTION \x1b[0mw\x1b[31mi\x1b[32mj \x1b[0mis ALWAYS a DOT PRODUCT            over \x1b[91mNEURON OUT-CONECTIONS \x1b[91m{\x1b[0mw\x1b[32mj\x1b[34mk\x1b[91m} \x1b[0mfor \x1b[91mOUT-NEURONS \x1b[91m{\x1b[0mn\x1b[34mk\x1b[91m} \x1b[92mout of \x1b[0mn\x1b[32mj\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0meach \x1b[92mI\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[31mi\x1b[91m} \x1b[0mfor \x1b[91mIN -NEURONS \x1b[91m{\x1b[0mn\x1b[31mi\x1b[91m} \x1b[92minto   \x1b[0mn\x1b[32mj\x1b[0m. eg. if \x1b[92mI\x1b[32m4 \x1b[0mis \x1b[91m{\x1b[31m0\x1b[91m,\x1b[31m1\x1b[91m}\x1b[0m, then n\x1b[31m0\x1b[0m,n\x1b[31m1 \x1b[0mgo   \x1b[92minto   \x1b[0mn\x1b[32m4\x1b[0m. n\x1b[31m0\x1b[0m,n\x1b[31m1 \x1b[0mcan simultaneously go   \x1b[92minto   \x1b[0mother neurons, say n\x1b[32m5\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0meach \x1b[92mO\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[34mk\x1b[91m} \x1b[0mfor \x1b[91mOUT-NEURONS \x1b[91m{\x1b[0mn\x1b[34mk\x1b[91m} \x1b[92mout of \x1b[0mn\x1b[32mj\x1b[0m. eg. if \x1b[92mO\x1b[32m0 \x1b[0mis \x1b[91m{\x1b[34m4\x1b[91m,\x1b[34m5\x1b[91m}\x1b[0m, then n\x1b[34m4\x1b[0m,n\x1b[34m5 \x1b[0mcome \x1b[92mout of \x1b[0mn\x1b[32m0\x1b[0m. n\x1b[34m4\x1b[0m,n\x1b[34m5 \x1b[0mcan simultaneously come \x1b[92mout of \x1b[0mother neurons, say n\x1b[32m1\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0meach factor in the summand \x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj \x1b[0min the dot product \x1b[35mSUM\x1b[91m[\x1b[34mk\x1b[91m,\x1b[92mO\x1b[32mj\x1b[91m, \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m] \x1b[0mtriggers \x1b[35mO\x1b[91m[\x1b[92mN\x1b[91m^\x1b[0m2\x1b[91m] \x1b[0mproducts? but there are many repeated computations: this is backpropagation\n");
+	nnlogf("\n");
+	nnlogf("\x1b[91m- \x1b[0ma \x1b[91mneural net \x1b[0mis a \x1b[91mdirected graph\x1b[0m, where the \x1b[91mvertices \x1b[0mare \x1b[91mneurons \x1b[0mand the \x1b[91medges \x1b[0mare \x1b[91mneuron connections\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0mthe \x1b[91mneuron connections \x1b[0mare the so-called \x1b[91mweights\x1b[0m\n");
+	nnlogf("\n");
+	nnlogf("\x1b[91m- \x1b[92mN                       \x1b[0mis the set of all INTEGERS in \x1b[91m[\x1b[0m0\x1b[91m..\x1b[92mN\x1b[91m)\x1b[0m, and also the number of \x1b[91mNEURONS\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[00mn\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all \x1b[91mNEURONS\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[35mf\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all \x1b[91mNEURON ACTIVATION FNS\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[92mI\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all sets of \x1b[91mNEURON IN -CONNECTION INDICES\x1b[0m, where each \x1b[92mI\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[31mi\x1b[91m} \x1b[0mfor \x1b[91mIN -NEURONS \x1b[91m{\x1b[0mn\x1b[31mi\x1b[91m} \x1b[92minto   \x1b[0mn\x1b[32mj\x1b[0m. used during fwd-prop\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[92mO\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m}          \x1b[0mis the set of all sets of \x1b[91mNEURON OUT-CONNECTION INDICES\x1b[0m, where each \x1b[92mO\x1b[32mj \x1b[0mis the set of all indices \x1b[91m{\x1b[34mk\x1b[91m} \x1b[0mfor \x1b[91mOUT-NEURONS \x1b[91m{\x1b[0mn\x1b[34mk\x1b[91m} \x1b[92mout of \x1b[0mn\x1b[32mj\x1b[0m. used during bwd-prop\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[31mi \x1b[91min \x1b[92mI\x1b[32mj\x1b[91m} \x1b[0mis the set of all \x1b[91mNEURON IN -CONNECTIONS \x1b[0mfrom neuron n\x1b[31mi \x1b[0mto neuron n\x1b[32mj \x1b[0m(aka. synapses, weights, parameters)\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[0mw\x1b[32mj\x1b[34mk \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[34mk \x1b[91min \x1b[92mO\x1b[34mk\x1b[91m} \x1b[0mis the set of all \x1b[91mNEURON OUT-CONNECTIONS \x1b[0mfrom neuron n\x1b[32mj \x1b[0mto neuron n\x1b[34mk \x1b[0m(aka. synapses, weights, parameters)\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[31mi \x1b[91min \x1b[92mI\x1b[32mj\x1b[91m} \x1b[0mand \x1b[91m{\x1b[0mw\x1b[32mj\x1b[34mk \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m, \x1b[34mk \x1b[91min \x1b[92mO\x1b[34mk\x1b[91m} \x1b[0mare isomorphic\n");
+	nnlogf("\x1b[91m- \x1b[91m{\x1b[92mI\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m} \x1b[0mand \x1b[91m{\x1b[92mO\x1b[32mj  \x1b[91m| \x1b[32mj \x1b[91min \x1b[92mN\x1b[91m} \x1b[0mare isomorphic, via graph ops. complexity may be \x1b[35mO\x1b[91m[\x1b[0mV\x1b[91m^\x1b[0m2\x1b[91m] \x1b[0mw/ a hash table for each index set \x1b[92mI\x1b[32mj\x1b[0m/\x1b[92mO\x1b[32mj\x1b[0m, or \x1b[35mO\x1b[91m[\x1b[0mV\x1b[91m^\x1b[0m2\x1b[91m*\x1b[0mE\x1b[91m] \x1b[0mw/ an array for each index set \x1b[92mI\x1b[32mj\x1b[0m/\x1b[92mO\x1b[32mj\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[0mto FULLY SPECIFY (the topology/connectivity of) a net (feedforward-only like fc/conv/recurrent nets, or feedforward/feedback like deep boltzmann machines).\n");
+	nnlogf("  it suffices to SPECIFY \x1b[92mN\x1b[0m, \x1b[35mf\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m, and \x1b[92mI\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m, OR\n");
+	nnlogf("  it suffices to SPECIFY \x1b[92mN\x1b[0m, \x1b[35mf\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m, and \x1b[92mO\x1b[32mj \x1b[0mfor each \x1b[32mj \x1b[91min \x1b[92mN\x1b[0m.\n");
+	nnlogf("  this representation is called the \x1b[91mNAL \x1b[0m(neural adjacency list), because it encodes the (topology/connectivity of) the net via \x1b[92mN \x1b[0msets of indices.\n");
+	nnlogf("  example (\x1b[91mNAL\x1b[0m).\n");
+	nnlogf("    let \x1b[92mN \x1b[0mbe \x1b[34m0x\x1b[35m0e\x1b[0m. now:\n");
+	nnlogf("      \x1b[91m- \x1b[0mthe \x1b[32mj\x1b[0m-indices             are in \x1b[91m{ \x1b[32m0\x1b[0m, \x1b[32m1\x1b[0m, \x1b[32m2\x1b[0m, \x1b[32m3\x1b[0m, \x1b[32m4\x1b[0m, \x1b[32m5\x1b[0m, \x1b[32m6\x1b[0m, \x1b[32m7\x1b[0m, \x1b[32m8\x1b[0m, \x1b[32m9\x1b[0m, \x1b[32ma\x1b[0m, \x1b[32mb\x1b[0m, \x1b[32mc\x1b[0m, \x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
+	nnlogf("      \x1b[91m- \x1b[0mthe neurons n\x1b[32mj            \x1b[0mare in \x1b[91m{\x1b[0mn\x1b[32m0\x1b[0m,n\x1b[32m1\x1b[0m,n\x1b[32m2\x1b[0m,n\x1b[32m3\x1b[0m,n\x1b[32m4\x1b[0m,n\x1b[32m5\x1b[0m,n\x1b[32m6\x1b[0m,n\x1b[32m7\x1b[0m,n\x1b[32m8\x1b[0m,n\x1b[32m9\x1b[0m,n\x1b[32ma\x1b[0m,n\x1b[32mb\x1b[0m,n\x1b[32mc\x1b[0m,n\x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
+	nnlogf("      \x1b[91m- \x1b[0mthe activation fns \x1b[35mf\x1b[32mj     \x1b[0mare in \x1b[91m{\x1b[35mf\x1b[32m0\x1b[0m,\x1b[35mf\x1b[32m1\x1b[0m,\x1b[35mf\x1b[32m2\x1b[0m,\x1b[35mf\x1b[32m3\x1b[0m,\x1b[35mf\x1b[32m4\x1b[0m,\x1b[35mf\x1b[32m5\x1b[0m,\x1b[35mf\x1b[32m6\x1b[0m,\x1b[35mf\x1b[32m7\x1b[0m,\x1b[35mf\x1b[32m8\x1b[0m,\x1b[35mf\x1b[32m9\x1b[0m,\x1b[35mf\x1b[32ma\x1b[0m,\x1b[35mf\x1b[32mb\x1b[0m,\x1b[35mf\x1b[32mc\x1b[0m,\x1b[35mf\x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
+	nnlogf("      \x1b[91m- \x1b[0mthe sets of in-indices \x1b[92mI\x1b[32mj \x1b[0mare in \x1b[91m{\x1b[92mI\x1b[32m0\x1b[0m,\x1b[92mI\x1b[32m1\x1b[0m,\x1b[92mI\x1b[32m2\x1b[0m,\x1b[92mI\x1b[32m3\x1b[0m,\x1b[92mI\x1b[32m4\x1b[0m,\x1b[92mI\x1b[32m5\x1b[0m,\x1b[92mI\x1b[32m6\x1b[0m,\x1b[92mI\x1b[32m7\x1b[0m,\x1b[92mI\x1b[32m8\x1b[0m,\x1b[92mI\x1b[32m9\x1b[0m,\x1b[92mI\x1b[32ma\x1b[0m,\x1b[92mI\x1b[32mb\x1b[0m,\x1b[92mI\x1b[32mc\x1b[0m,\x1b[92mI\x1b[32md\x1b[0m\x1b[91m}\x1b[0m\n");
+	nnlogf("    let \x1b[92mI\x1b[32m0 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m0 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
+	nnlogf("    let \x1b[92mI\x1b[32m1 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m1 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
+	nnlogf("    let \x1b[92mI\x1b[32m2 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m2 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
+	nnlogf("    let \x1b[92mI\x1b[32m3 \x1b[0mbe \x1b[91m{\x1b[0m\x1b[91m}         \x1b[0mso n\x1b[32m3 \x1b[0mcomes from nothing.     layer \x1b[35m0\x1b[0m: length \x1b[35m0 \x1b[0mdependency chain (input neuron: no inputs)\n");
+	nnlogf("    let \x1b[92mI\x1b[32m4 \x1b[0mbe \x1b[91m{\x1b[0m0\x1b[91m,\x1b[0m1\x1b[91m}\x1b[0m.     so n\x1b[32m4 \x1b[0mcomes from n\x1b[31m0\x1b[0m,n\x1b[31m1\x1b[0m.       layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32m5 \x1b[0mbe \x1b[91m{\x1b[0m0\x1b[91m,\x1b[0m1\x1b[91m,\x1b[0m2\x1b[91m}\x1b[0m.   so n\x1b[32m5 \x1b[0mcomes from n\x1b[31m0\x1b[0m,n\x1b[31m1\x1b[0m,n\x1b[31m2\x1b[0m.    layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32m6 \x1b[0mbe \x1b[91m{\x1b[0m1\x1b[91m,\x1b[0m2\x1b[91m,\x1b[0m3\x1b[91m}\x1b[0m.   so n\x1b[32m6 \x1b[0mcomes from n\x1b[31m1\x1b[0m,n\x1b[31m2\x1b[0m,n\x1b[31m3\x1b[0m.    layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32m7 \x1b[0mbe \x1b[91m{\x1b[0m2\x1b[91m,\x1b[0m3\x1b[91m}\x1b[0m.     so n\x1b[32m7 \x1b[0mcomes from n\x1b[31m2\x1b[0m,n\x1b[31m3\x1b[0m.       layer \x1b[35m1\x1b[0m: length \x1b[35m1 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32m8 \x1b[0mbe \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m}\x1b[0m.     so n\x1b[32m8 \x1b[0mcomes from n\x1b[31m4\x1b[0m,n\x1b[31m5\x1b[0m.       layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32m9 \x1b[0mbe \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m}\x1b[0m.   so n\x1b[32m9 \x1b[0mcomes from n\x1b[31m4\x1b[0m,n\x1b[31m5\x1b[0m,n\x1b[31m6\x1b[0m.    layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32ma \x1b[0mbe \x1b[91m{\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.   so n\x1b[32ma \x1b[0mcomes from n\x1b[31m5\x1b[0m,n\x1b[31m6\x1b[0m,n\x1b[31m7\x1b[0m.    layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32mb \x1b[0mbe \x1b[91m{\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.     so n\x1b[32mb \x1b[0mcomes from n\x1b[31m6\x1b[0m,n\x1b[31m7\x1b[0m.       layer \x1b[35m2\x1b[0m: length \x1b[35m2 \x1b[0mdependency chain\n");
+	nnlogf("    let \x1b[92mI\x1b[32mc \x1b[0mbe \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m. so n\x1b[32mc \x1b[0mcomes from n\x1b[31m8\x1b[0m,n\x1b[31m9\x1b[0m,n\x1b[31ma\x1b[0m,n\x1b[31mb\x1b[0m. layer \x1b[35m3\x1b[0m: length \x1b[35m3 \x1b[0mdependency chain (output neuron: no outputs)\n");
+	nnlogf("    let \x1b[92mI\x1b[32md \x1b[0mbe \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m. so n\x1b[32mc \x1b[0mcomes from n\x1b[31m8\x1b[0m,n\x1b[31m9\x1b[0m,n\x1b[31ma\x1b[0m,n\x1b[31mb\x1b[0m. layer \x1b[35m3\x1b[0m: length \x1b[35m3 \x1b[0mdependency chain (output neuron: no outputs)\n");
+	nnlogf("    now \x1b[92mO\x1b[32m0 \x1b[0mis \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m}\x1b[0m.     so n\x1b[32m0 \x1b[0mgoes  into n\x1b[34m4\x1b[0m,n\x1b[34m5\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m1 \x1b[0mis \x1b[91m{\x1b[0m4\x1b[91m,\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m}\x1b[0m.   so n\x1b[32m1 \x1b[0mgoes  into n\x1b[34m4\x1b[0m,n\x1b[34m5\x1b[0m,n\x1b[34m6\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m2 \x1b[0mis \x1b[91m{\x1b[0m5\x1b[91m,\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.   so n\x1b[32m2 \x1b[0mgoes  into n\x1b[34m5\x1b[0m,n\x1b[34m6\x1b[0m,n\x1b[34m7\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m3 \x1b[0mis \x1b[91m{\x1b[0m6\x1b[91m,\x1b[0m7\x1b[91m}\x1b[0m.     so n\x1b[32m3 \x1b[0mgoes  into n\x1b[34m6\x1b[0m,n\x1b[34m7\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m4 \x1b[0mis \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m\x1b[91m}\x1b[0m.     so n\x1b[32m4 \x1b[0mgoes  into n\x1b[34m8\x1b[0m,n\x1b[34m9\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m5 \x1b[0mis \x1b[91m{\x1b[0m8\x1b[91m,\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m}\x1b[0m.   so n\x1b[32m5 \x1b[0mgoes  into n\x1b[34m8\x1b[0m,n\x1b[34m9\x1b[0m,n\x1b[34ma\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m6 \x1b[0mis \x1b[91m{\x1b[0m9\x1b[91m,\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m.   so n\x1b[32m6 \x1b[0mgoes  into n\x1b[34m9\x1b[0m,n\x1b[34ma\x1b[0m,n\x1b[34mb\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m7 \x1b[0mis \x1b[91m{\x1b[0ma\x1b[91m,\x1b[0mb\x1b[91m}\x1b[0m.     so n\x1b[32m7 \x1b[0mgoes  into n\x1b[34ma\x1b[0m,n\x1b[34mb\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m8 \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32m8 \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32m9 \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32m9 \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32ma \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32ma \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32mb \x1b[0mis \x1b[91m{\x1b[0mc\x1b[91m,\x1b[0md\x1b[91m}\x1b[0m.     so n\x1b[32mb \x1b[0mgoes  into n\x1b[34mc\x1b[0m,n\x1b[34md\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32mc \x1b[0mis \x1b[91m{\x1b[91m}\x1b[0m.        so n\x1b[32mc \x1b[0mgoes  into nothing\x1b[0m\n");
+	nnlogf("    now \x1b[92mO\x1b[32md \x1b[0mis \x1b[91m{\x1b[91m}\x1b[0m.        so n\x1b[32md \x1b[0mgoes  into nothing\x1b[0m\n");
+	nnlogf("    this specifies a net with: 4 inputs, a 4-neuron (sparsely-connected) hidden layer, a 4-neuron (sparsely-connected) hidden layer, and 2 outputs\n");
+	nnlogf("\x1b[91m- \x1b[0mthe \"number of layers\" is an implicit number given in the NAL/NAM, defined as the longest chain in a topological sort of the connectivity graph (implicitly) given by the NAL/NAM\n");
+}
+
+fdef void nirshow(nir_t* nir){
+	i64 N = nir->N;
+	nnlogf("\n");
+	mfor(j,0,N) nnlogf("\x1b[35mf\x1b[32m%02lx\x1b[91m:\x1b[35m%02x\x1b[0m\n",j,nir->F[j]);
+
+	nnlogf("\n");
+	mfor(j,0,N){
+		nnlogf("\x1b[92mI\x1b[32m%02lx\x1b[91m:",j);
+		for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e) nnlogf(" \x1b[32m%02x",nir->Iidx[e]);
+		nnlogf("\x1b[0m\n");
+	}
+	nnlogf("IN \x1b[34m%'lu\x1b[0m\n", nir->Ioff[N]);
+
+	nnlogf("\n");
+	mfor(j,0,N){
+		nnlogf("\x1b[92mO\x1b[32m%02lx\x1b[91m:",j);
+		for(u64 e=nir->Ooff[j]; e<nir->Ooff[j+1]; ++e) nnlogf(" \x1b[32m%02x",nir->Oidx[e]);
+		nnlogf("\x1b[0m\n");
+	}
+	nnlogf("ON \x1b[34m%'lu\x1b[0m\n", nir->Ooff[N]);
+
+	// ----------------------------------------------------------------
+	nnlogf("\n\x1b[92mfwd-prop\x1b[0m\n");
+	mfor(j,0,N){
+		if(nir_idim(nir,j)==0)  continue;
+		nnlogf("n%02lx = f%02lx(",j,j);
+		for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e) nnlogf(" +n%02x*w%02x%02lx",nir->Iidx[e],nir->Iidx[e],j);
+		nnlogf(")\n");
+	}
+
+	// ----------------------------------------------------------------
+	nnlogf("\n\x1b[92mbwd-prop\x1b[0m\n");  // reverse-mode: the delta dj = DLY_zj of neuron nj (zj is its pre-activation) is fj' times the sum of the deltas of its out-neurons, weighted by their edges. an output neuron gets DLY_nj instead of that sum
+	mfor(j,0,N){
+		if(nir_idim(nir,j)==0)  continue;
+		nnlogf("\x1b[34md\x1b[32m%02lx \x1b[91m= \x1b[35mf\x1b[32m%02lx\x1b[91m'(\x1b[0mz\x1b[32m%02lx\x1b[91m) *",j,j,j);
+		if(nir_odim(nir,j)==0){  nnlogf(" \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[0mn\x1b[32m%02lx\x1b[0m\n",j);  continue;  }
+		nnlogf(" \x1b[91m(");
+		for(u64 o=nir->Ooff[j]; o<nir->Ooff[j+1]; ++o){
+			u32 k = nir->Oidx[o];
+			nnlogf(" \x1b[91m+\x1b[0mw\x1b[32m%02lx\x1b[34m%02x\x1b[91m*\x1b[34md%02x\x1b[0m",j,k,k);
+		}
+		nnlogf("\x1b[91m)\x1b[0m\n");
+	}
+	mfor(j,0,N)
+		for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){
+			u32 i = nir->Iidx[e];
+			nnlogf("\x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31m%02x\x1b[32m%02lx \x1b[91m= \x1b[34md\x1b[32m%02lx\x1b[91m*\x1b[0mn\x1b[31m%02x\x1b[0m\n",i,j,j,i);
+		}
+}
 
 fdef void namshow(i64 n, u32* NAM){
-	sep(); print("\x1b[92m%c\x1b[0m\n", __func__);
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
 	i64 C = divceilu(n,32);  // cols
-	print("\x1b[31m%,d \x1b[32m%,d\x1b[0m\n", n,C);
+	nnlogf("\x1b[31m%'ld \x1b[32m%'ld\x1b[0m\n", n,C);
 	mfor(i, 0,n){
 		mfor(j, 0,C)
-			printf("%s", fmtbl(NAM[i*C+j],n));
-		putchar(0x0a);
+			nnlogf("%s", fmtbl(NAM[i*C+j],n));
+		nnlogf("\n");
 	}
 }
 
 fdef void opsshow(u32** ops){  // @arg ops  a vector of type u32[2], ie. u32[][]  // nj = fj[SUM[i,Ij, ni*wij]]  // THE VALUE OF EACH NEURON nj IS ALWAYS ALWAYS A SIMPLE DOT PRODUCT
-	sep();
-	print("\x1b[92m%c\x1b[0m\n", __func__);
-	print("\x1b[91m- \x1b[0mn\x1b[32mj       \x1b[0m\x1b[91m= \x1b[35mf\x1b[32mj\x1b[91m[\x1b[35mSUM\x1b[91m[\x1b[31mi\x1b[91m,\x1b[92mI\x1b[32mj\x1b[91m, \x1b[0mn\x1b[31mi\x1b[91m*\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]]\x1b[0m\n");
-	print("\x1b[91m- \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m=    \x1b[35mSUM\x1b[91m[\x1b[34mk\x1b[91m,\x1b[92mO\x1b[32mj\x1b[91m, \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]\x1b[0m\n");
+	nnlogf("\n"M_SEP);
+	nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	nnlogf("\x1b[91m- \x1b[0mn\x1b[32mj       \x1b[0m\x1b[91m= \x1b[35mf\x1b[32mj\x1b[91m[\x1b[35mSUM\x1b[91m[\x1b[31mi\x1b[91m,\x1b[92mI\x1b[32mj\x1b[91m, \x1b[0mn\x1b[31mi\x1b[91m*\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]]\x1b[0m\n");
+	nnlogf("\x1b[91m- \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mw\x1b[31mi\x1b[32mj \x1b[91m=    \x1b[35mSUM\x1b[91m[\x1b[34mk\x1b[91m,\x1b[92mO\x1b[32mj\x1b[91m, \x1b[34mD\x1b[0mLY\x1b[91m_\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34mk\x1b[91m_\x1b[0mw\x1b[31mi\x1b[32mj\x1b[91m]\x1b[0m\n");
 
 	mfor(i, 0,vidim(ops)){
 		u32* row = ops[i];
-		printf("n%02x = f%02x(", i,i);  // printf("%c = f(",0x61+i);  printf("n%02x = f(",i);
+		nnlogf("n%02lx = f%02lx(", i,i);  // printf("%c = f(",0x61+i);  printf("n%02x = f(",i);
 		vfor(row,it1)
 #if 0
 			switch(*it1){
-				case OPADD: printf(" + ");          break;  // putchar(0x2b);
-				case OPMUL: putchar(0x2a);          break;  // printf(" * w");
-				default:    printf("%c",0x61+*it1); break;
+				case OPADD: nnlogf(" + ");          break;  // putchar(0x2b);
+				case OPMUL: nnlogf("*");          break;  // printf(" * w");
+				default:    nnlogf("%c",0x61+*it1); break;
 			}
 #endif
 #if 1  // n{0kx:i} means the output of neuron i (where neurons are indexed using k hex digits  // w{0kx:i}{0kx:j} means the weight connection neuron n{0kx:i} to neuron n{0kx:j}
 		switch(*it1){
-			case OPADD: printf(" +n");       break;  // putchar(0x2b);
-			case OPMUL: printf("*w");        break;  // putchar(0x2a); printf(" * w"); printf("*w");
-			default:    printf("%02x",*it1); break;
+			case OPADD: nnlogf(" +n");       break;  // putchar(0x2b);
+			case OPMUL: nnlogf("*w");        break;  // putchar(0x2a); printf(" * w"); printf("*w");
+			default:    nnlogf("%02x",*it1); break;
 		}
 #endif
 			// printf(" %02x",*it1);
-		printf(")\n");
+		nnlogf(")\n");
 	}
 }
 
@@ -159,33 +298,103 @@ fdef void opsshow(u32** ops){  // @arg ops  a vector of type u32[2], ie. u32[][]
 	_n;                                                                         \
 })
 
-fdef void nirparse(i64 tbdim,u8* tdata, i64* on){
-	sep(); print("\x1b[92m%c\x1b[0m\n", __func__);
-	if(tbdim<3){ fail("file is too small: %'d bytes"); exit(1); }
+// @meta  NAL parse chunk: a run of whole lines (`j fj Ij`) that starts at a line start. each thread parses 1 chunk into a chunk-local in-CSR, and the chunks are then merged w/ a prefix sum over their neuron/edge counts
+tdef{
+	i64  bdim;          // chunk size, in bytes
+	u8*  data;          // chunk data, starts at a line start and ends after a linefeed (or at EOF)
+	i64  N;             // for the in-index range check
+	u64  line;          // line number of the 1st line of the chunk, for error messages
+	i64  nlines;        // number of lines in the chunk, used to pre-size F/Ioff
+	i64  j0;            // neuron index of the 1st line of the chunk, checked after the merge
+	i64  jbad;          // line number of the 1st line whose neuron index isn't j0 + its position in the chunk, or -1. checked after the merge
+	u8*  F;             // chunk-local vec of activation fn codes
+	u64* Ioff;          // chunk-local vec of in-CSR offsets, relative to the chunk's Iidx. no final entry
+	u32* Iidx;          // chunk-local vec of in-CSR indices
+	u64  joff,eoff;     // merge: position of the chunk's 1st neuron/edge in the global F/Ioff and Iidx
+	nir_t* nir;         // merge: the global IR
+}nirpchunk_t;
 
-	// ----------------------------------------------------------------
-	u64 line = 0;
-	if(*tdata==0x25){
-		while(tbdim && *tdata!=0x0a){ --tbdim; ++tdata; }  // line0 is a comment
-		--tbdim; ++tdata;  // skip 0x0a
-		++line;
-	}
+fdef i64 nirp_nlines(u8* data,i64 bdim){  // @meta  the number of lines in a chunk, ie. the number of linefeeds, plus 1 if the last line has no linefeed
+	if(bdim<=0) return 0;
+#if __avx2__
+	i64 nlines = nlines_avx2(data,bdim) - 1;
+#else
+	i64 nlines = 0;
+	for(u8* it=data; (it=memchr(it,0x0a,data+bdim-it))!=NULL; ++it)  ++nlines;
+#endif
+	return nlines + (data[bdim-1]!=0x0a);
+}
 
-	u8 val0 = *tdata; --tbdim; ++tdata;
-	u8 val1 = *tdata; --tbdim; ++tdata;
-	if(val0!=0x4e && val0!=0x6e){ fail("character 0 must be N or n");  exit(1); }
-	if(val1!=0x20){               fail("character 1 must be a space"); exit(1); }
+#if NIRP_SIMD
+// @meta  NAL parse an in-index list, 32 bytes at a time. classify each 32-byte block into hex-digit, separator (comma/space) and linefeed masks, map every byte to its nibble, and then, for each run of hex digits, gather its (at most 8) nibbles into a u64 and fold them into a u32 w/ 3 SWAR shift/or/mask steps
+// consume whole in-indices and the separators between them, and stop at the separator (or linefeed) after the last in-index, ie. in the same state as after a scalar @nirpu64(). stop early at anything unusual (empty/long runs, bad bytes, out-of-range in-indices, the end of the chunk) and let the scalar path deal w/ it (and report it)
+// @ret  the number of bytes consumed, or 0 if no in-index was decoded
+fdef i64 nirp_hexlist_avx2(i64 tbdim,u8* tdata, i64 N, u32** oIidx){
+	u32* Iidx = *oIidx;
+	u8   nib[8+32] = {0x00};  // nibbles, w/ an 8-byte zero prefix so that every run can be loaded as the u64 that ends at it
+	i64  pos  = 0;  // the start of the current run
+	i64  end  = 0;  // the position of the separator after the last decoded in-index
+	__m256i v0  = _mm256_set1_epi8(0x30-1), v9  = _mm256_set1_epi8(0x39+1);
+	__m256i va  = _mm256_set1_epi8(0x61-1), vf  = _mm256_set1_epi8(0x66+1);
+	__m256i vcm = _mm256_set1_epi8(0x2c),   vsp = _mm256_set1_epi8(0x20), vlf = _mm256_set1_epi8(0x0a);
+	__m256i v0f = _mm256_set1_epi8(0x0f),   v09 = _mm256_set1_epi8(0x09);
+	while(pos+32<=tbdim){
+		__m256i c   = _mm256_loadu_si256((__m256i*)(tdata+pos));
+		__m256i dig = _mm256_and_si256(_mm256_cmpgt_epi8(c,v0), _mm256_cmpgt_epi8(v9,c));
+		__m256i lo  = _mm256_and_si256(_mm256_cmpgt_epi8(c,va), _mm256_cmpgt_epi8(vf,c));
+		__m256i sep = _mm256_or_si256( _mm256_cmpeq_epi8(c,vcm),_mm256_cmpeq_epi8(c,vsp));
+		u32     hexm = _mm256_movemask_epi8(_mm256_or_si256(dig,lo));
+		u32     sepm = _mm256_movemask_epi8(sep);
+		u32     lfm  = _mm256_movemask_epi8(_mm256_cmpeq_epi8(c,vlf));
+		_mm256_storeu_si256((__m256i*)(nib+8), _mm256_add_epi8(_mm256_and_si256(c,v0f), _mm256_and_si256(lo,v09)));  // asciihex_to_u4(), 32 at a time
 
-	// ----------------------------------------------------------------
-	i64 N = nirpu64(tbdim,tdata,line);  nirpchk(tbdim,tdata,line,*tdata!=0x0a, "expected linefeed");
-	--tbdim; ++tdata;  // skip 0x0a
-	++line;
-	print("\n\x1b[92mN \x1b[34m%,d\x1b[0m\n",N);
+		u32 lim  = lfm ? lfm & -lfm : 0;  lim = lim ? (lim<<1)-1 : 0xffffffffu;  // everything up to (and including) the 1st linefeed
+		u32 badm = ~(hexm|sepm|lfm) & lim;  if(badm)  lim &= (badm & -badm)-1;    // ... and before the 1st bad byte
+		u32 endm = (sepm|lfm) & lim;  // run terminators
+		if(endm==0)  break;
 
-	// ----------------------------------------------------------------
-	u64*  F = vini(u64);  // a vec of ints, where each int is the code for an activation fn
-	u64** I = vini(u64);  // a vec of vecs of in -indices
-	u64** O = vini(u64);  // a vec of vecs of out-indices
+		i64 s = 0;  // run start, relative to the block
+		while(endm){
+			i64 e = __builtin_ctz(endm);  endm &= endm-1;
+			i64 L = e-s;
+			if(L<1 || 8<L)  goto done;
+			u64 x;  memcpy(&x, nib+e, 8);  // unaligned: memcpy() is 1 mov, and not UB
+			x &= ~0ull << (8*(8-L));  // the run's nibbles, 1 per byte, most significant first; lower bytes zeroed
+			x = ((x<< 4) | (x>> 8)) & 0x00ff00ff00ff00ffull;  //  8 nibbles ->  4 bytes
+			x = ((x<< 8) | (x>>16)) & 0x0000ffff0000ffffull;  //  4 bytes   ->  2 u16s
+			x = ((x<<16) | (x>>32)) & 0x00000000ffffffffull;  //  2 u16s    ->  1 u32
+			if(N<=(i64)x)  goto done;
+			vpush(Iidx,x);
+			end = pos+e;
+			if(tdata[end]==0x0a)  goto done;
+			s = e+1;
+		}
+		if(s==0)  break;
+		pos += s;
+	}
+done:
+	*oIidx = Iidx;
+	return end;
+}
+#endif
+
+fdef void* nirp_count(void* arg){
+	nirpchunk_t* c = (nirpchunk_t*)arg;
+	c->nlines = nirp_nlines(c->data,c->bdim);
+	return NULL;
+}
+
+fdef void* nirp_parse(void* arg){
+	nirpchunk_t* c     = (nirpchunk_t*)arg;
+	i64          tbdim = c->bdim;
+	u8*          tdata = c->data;
+	u64          line  = c->line;
+	i64          N     = c->N;
+	u8*  F    = vini1(u8, c->nlines+1);  // a vec of ints, where each int is the code for an activation fn
+	u64* Ioff = vini1(u64,c->nlines+1);  // a vec of in-CSR offsets: Ioff[j] is the position in Iidx of the first in-index of neuron nj
+	u32* Iidx = vini(u32);               // a vec of in-CSR indices
+	c->j0   = -1;
+	c->jbad = -1;
 
 	u8  val;
 	u64 j;  // neuron index @j for neuron @nj
@@ -193,139 +402,283 @@ fdef void nirparse(i64 tbdim,u8* tdata, i64* on){
 	while(0<tbdim){
 		switch(state){  // at each step of this state machine, consume 1 u64
 			case 0x0:{  // 0: line ini
-				j = nirpu64(tbdim,tdata,line);  nirpchk(tbdim,tdata,line,j!=vidim(I), "0: skipped neuron index \x1b[32m%02x \x1b[0mfor neuron n\x1b[32m%02x\x1b[0m",vidim(I),vidim(I));
-				vpush(I,vini(u64));
+				j = nirpu64(tbdim,tdata,line);
+				if(vidim(F)==0)                     c->j0   = j;
+				if(c->jbad<0 && j!=c->j0+vidim(F))  c->jbad = line;  // skipped neuron indices are reported after the merge, since only then do we know where the chunk starts
+				vpush(Ioff,vidim(Iidx));
 				vpush(F,0x00);
-				printf(" \x1b[32m%02x\x1b[0m",j);
+				nnlogf(" \x1b[32m%02lx\x1b[0m",j);
 				val = *tdata;
 				if(     0<tbdim && (val==0x0a)) state=0x0;  // 0: line ini
 				else if(0<tbdim && (val==0x20)) state=0x1;  // 1: after j
 				else{                           nirpchk(tbdim,tdata,line,1, "0: unexpected character"); }
 			}break;
 			case 0x1:{  // 1: after j (must come fj)
-				u64 fj = nirpu64(tbdim,tdata,line);
-				F[j] = fj;
-				printf(" \x1b[35m%02x\x1b[0m",fj);
+				u64 fj = nirpu64(tbdim,tdata,line);  nirpchk(tbdim,tdata,line,0x06<fj, "1: unknown activation fn code \x1b[35m%02lx\x1b[0m",fj);  // before it's truncated to a u8
+				F[vidim(F)-1] = fj;
+				nnlogf(" \x1b[35m%02lx\x1b[0m",fj);
 				val = *tdata;
 				nirpchk(tbdim,tdata,line,tbdim<=0,  "1: early end of file");
 				nirpchk(tbdim,tdata,line,val!=0x20, "1: unexpected character");
 				state=0x2;  // 2: i-indices
 			}break;
 			case 0x2:{
-				u64 i = nirpu64(tbdim,tdata,line);
-				vpush(I[j],i);
-				printf(" \x1b[31m%02x\x1b[0m",i);
+#if NIRP_SIMD
+				if(!nnverbose()){
+					i64 k = nirp_hexlist_avx2(tbdim,tdata, N,&Iidx);
+					if(0<k){  tbdim-=k; tdata+=k;  if(*tdata==0x0a) state=0x0;  break;  }
+				}
+#endif
+				u64 i = nirpu64(tbdim,tdata,line);  nirpchk(tbdim,tdata,line,N<=i, "2: in-index \x1b[31m%02lx \x1b[0mout of range",i);
+				vpush(Iidx,i);
+				nnlogf(" \x1b[31m%02lx\x1b[0m",i);
 				val = *tdata;
 				if(0<tbdim && val!=0x2c && val!=0x0a) nirpchk(tbdim,tdata,line,val!=0x20, "2: unexpected character");
 				if(val==0x0a) state=0x0;  // 0: line ini
 			}break;
 		}
-		if(*tdata==0x0a || tbdim<=0){ ++line; putchar(0x0a); }
+		if(*tdata==0x0a || tbdim<=0){ ++line; nnlogf("\n"); }
 		--tbdim; ++tdata;
 	}
-	nnchk(N!=vidim(I), "N mismatch: %'d %'d", N,vidim(I));
+	c->F=F; c->Ioff=Ioff; c->Iidx=Iidx;
+	return NULL;
+}
+
+fdef void* nirp_merge(void* arg){
+	nirpchunk_t* c   = (nirpchunk_t*)arg;
+	nir_t*       nir = c->nir;
+	i64          n   = vidim(c->F);
+	memcpy(nir->F   +c->joff, c->F,    n);
+	memcpy(nir->Iidx+c->eoff, c->Iidx, Bsize(u32)*vidim(c->Iidx));
+	mfor(k,0,n)  nir->Ioff[c->joff+k] = c->eoff + c->Ioff[k];
+	vend(c->F); vend(c->Ioff); vend(c->Iidx);
+	return NULL;
+}
+
+fdef void nirp_run(i64 nthreads,nirpchunk_t* chunks, void* (*fn)(void*)){  // @meta  run @fn over all chunks, 1 thread per chunk. chunk 0 runs on the calling thread
+	pthread_t* threads = alloca(sizeof(pthread_t)*nthreads);
+	mfor(t,1,nthreads)  nnchk(pthread_create(&threads[t],NULL, fn,&chunks[t])!=0, "can't create thread %ld", t);
+	fn(&chunks[0]);
+	mfor(t,1,nthreads)  pthread_join(threads[t],NULL);
+}
+
+// @meta  NAL parse the header: an optional comment line, and then the N line. advance @tbdim/@tdata/@line past it. @ret  N
+fdef i64 nirp_head(i64* otbdim,u8** otdata,u64* oline){
+	i64 tbdim = *otbdim;
+	u8* tdata = *otdata;
+	u64 line  = *oline;
+	if(tbdim<3){ fail("file is too small: %'d bytes"); exit(1); }
 
 	// ----------------------------------------------------------------
-	mfor(j0,0,N){  // O[V^2*E] using an array to store in-indices, O[V^2] using a hash table to store in-indices
-		vpush(O,vini(u64));
-		mfor(j1,0,N)
-			if(viget(I[j1],j0)!=-1) vpush(O[j0],j1);  // printf("%2d %2d %2d %2d %d\n", j0,j1,viget(I[j1],j0), viget(O[j0],j1), viget(I[j1],j0)!=-1);
+	if(*tdata==0x25){
+		while(tbdim && *tdata!=0x0a){ --tbdim; ++tdata; }  // line0 is a comment
+		--tbdim; ++tdata;  // skip 0x0a
+		++line;
 	}
 
+	u8 val0 = *tdata; --tbdim; ++tdata;
+	u8 val1 = *tdata; --tbdim; ++tdata;
+	if(val0!=0x4e && val0!=0x6e){ fail("character 0 must be N or n");  exit(1); }
+	if(val1!=0x20){               fail("character 1 must be a space"); exit(1); }
+
 	// ----------------------------------------------------------------
-	putchar(0x0a);
-	mfor(j,0,N) printf("\x1b[35mf\x1b[32m%02x\x1b[91m:\x1b[35m%02x\x1b[0m\n",j,F[j]);
+	i64 N = nirpu64(tbdim,tdata,line);  nirpchk(tbdim,tdata,line,*tdata!=0x0a, "expected linefeed");
+	--tbdim; ++tdata;  // skip 0x0a
+	++line;
+	nnlogf("\n\x1b[92mN \x1b[34m%'ld\x1b[0m\n",N);
+	nnchk(0xffffffffll<N, "N too large: %'ld", N);
+	*otbdim=tbdim; *otdata=tdata; *oline=line;
+	return N;
+}
 
-	putchar(0x0a);
-	u64 IN = 0;
-	mfor(j,0,N){
-		printf("\x1b[92mI\x1b[32m%02x\x1b[91m:",j);
-		vfor(I[j],i) printf(" \x1b[32m%02x",*i);
-		printf("\x1b[0m\n");
-		IN += vidim(I[j]);
+// @meta  NAL parse a run of whole lines (starting at line @line) and append their neurons/edges to the in-CSR of @nir, whose N must be set. F/Ioff/Iidx are vecs (or NULL, if there's nothing yet) and Ioff has no final entry. the caller checks that all N neurons came. @ret  the number of lines
+fdef i64 nirp_lines(i64 tbdim,u8* tdata, u64 line, i64 nthreads, nir_t* nir){
+	// ----------------------------------------------------------------  split the lines into chunks at linefeeds, 1 chunk per thread. the parse trace is only sequential if there's 1 chunk
+	if(nnverbose())  nthreads = 1;
+	nthreads = mmax(1, mmin(nthreads, divceilu(mmax(tbdim,1), NIRP_CHUNK_BDIM_MIN)));
+	nirpchunk_t* chunks = alloca(sizeof(nirpchunk_t)*nthreads);  memset(chunks,0x00,sizeof(nirpchunk_t)*nthreads);
+	u8* end = tdata + mmax(tbdim,0);
+	u8* pos = tdata;
+	mfor(t,0,nthreads){
+		u8* cend = t==nthreads-1 ? end : mmax(pos, tdata + (end-tdata)*(t+1)/nthreads);
+		if(cend<end){  u8* lf=memchr(cend,0x0a,end-cend);  cend = lf==NULL ? end : lf+1;  }
+		chunks[t] = (nirpchunk_t){bdim:cend-pos, data:pos, N:nir->N};
+		pos = cend;
 	}
-	print("IN \x1b[34m%,d\x1b[0m\n", IN);
 
-	putchar(0x0a);
-	u64 ON = 0;
-	mfor(j,0,N){
-		printf("\x1b[92mO\x1b[32m%02x\x1b[91m:",j);
-		vfor(O[j],i) printf(" \x1b[32m%02x",*i);
-		printf("\x1b[0m\n");
-		ON += vidim(O[j]);
+	nirp_run(nthreads,chunks, nirp_count);  // O[bdim/nthreads]
+	mfor(t,1,nthreads)  chunks[t].line = chunks[t-1].line + chunks[t-1].nlines;
+	mfor(t,0,nthreads)  chunks[t].line += line;
+	nirp_run(nthreads,chunks, nirp_parse);  // O[bdim/nthreads]
+
+	// ----------------------------------------------------------------  merge: prefix sum over the neuron/edge counts, then validate the neuron indices
+	i64 NF = nir->F   ==NULL ? 0 : vidim(nir->F);
+	i64 E  = nir->Iidx==NULL ? 0 : vidim(nir->Iidx);
+	mfor(t,0,nthreads){
+		nirpchunk_t* c = &chunks[t];
+		c->joff = NF;  NF += vidim(c->F);
+		c->eoff = E;   E  += vidim(c->Iidx);
+		if(vidim(c->F)==0)  continue;
+		nnchk(c->j0!=c->joff, "line \x1b[34m%'lu\x1b[0m: skipped neuron index \x1b[32m%02lx \x1b[0mfor neuron n\x1b[32m%02lx\x1b[0m", c->line, c->joff,c->joff);
+		nnchk(0<=c->jbad,    "line \x1b[34m%'ld\x1b[0m: skipped neuron index",                                                     c->jbad);
 	}
-	print("ON \x1b[34m%d\x1b[0m\n", ON);
 
-	// ----------------------------------------------------------------
-	print("\n\x1b[92mfwd-prop\x1b[0m\n");
-	mfor(j,0,N){
-		if(vidim(I[j])==0)  continue;
-		printf("n%02x = f%02x(",j,j);
-		vfor(I[j],i) printf(" +n%02x*w%02x%02x",*i,*i,j);
-		printf(")\n");
+	if(nir->F==NULL && nthreads==1){  // a single chunk is already the global in-CSR
+		nir->F=chunks[0].F; nir->Ioff=chunks[0].Ioff; nir->Iidx=chunks[0].Iidx;
+	}else{
+		if(nir->F==NULL){  nir->F=vini1(u8,NF+1);  nir->Ioff=vini1(u64,NF+1);  nir->Iidx=vini1(u32,E+1);  }
+		if(vidimmax(nir->F)   <=NF)  v_resize(nir->F,    mmax(NF+1, 2*vidimmax(nir->F)));  // appending windows grow geometrically
+		if(vidimmax(nir->Ioff)<=NF)  v_resize(nir->Ioff, mmax(NF+1, 2*vidimmax(nir->Ioff)));
+		if(vidimmax(nir->Iidx)<=E)   v_resize(nir->Iidx, mmax(E +1, 2*vidimmax(nir->Iidx)));
+		vidim(nir->F)=NF;  vidim(nir->Ioff)=NF;  vidim(nir->Iidx)=E;
+		mfor(t,0,nthreads)  chunks[t].nir = nir;
+		nirp_run(nthreads,chunks, nirp_merge);  // O[(N+E)/nthreads]
 	}
+	nir->E = E;
+	return chunks[nthreads-1].line + chunks[nthreads-1].nlines - line;
+}
 
-	// ----------------------------------------------------------------
-	print("\n\x1b[92mbwd-prop\x1b[0m\n");
-	mfor(j,0,N)
-		vfor(I[j],i){
-			printf("w%02x%02x = ",*i,j);
-			vfor(O[j],k)
-				printf(" \x1b[91m+\x1b[34mD\x1b[0mLY\x1b[91m_\x1b[0mn\x1b[34m%02x\x1b[91m*\x1b[34mD\x1b[0mn\x1b[34m%02x\x1b[91m_\x1b[0mw\x1b[31m%02x\x1b[32m%02x\x1b[0m",*k,*k,*i,j);  // printf(" +DLY_n%02x*Dn%02x_w%02x%02x",*k,*i,j);
-			putchar(0x0a);
-		}
+fdef void nirparse(i64 tbdim,u8* tdata, i64 nthreads, nir_t* onir){  // @ret  the graph IR, with the in-CSR built while parsing and the out-CSR derived from it (caller must nir_end() it)
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	u64 line = 0;
+	nir_t nir = {N:nirp_head(&tbdim,&tdata,&line)};
+	nirp_lines(tbdim,tdata,line, nthreads, &nir);
+	nnchk(nir.N!=vidim(nir.F), "N mismatch: %'ld %'ld", nir.N,vidim(nir.F));
+	vpush(nir.Ioff,nir.E);
 
 	// ----------------------------------------------------------------
-	vend(F);
-	vfor(I,it) vend(*it);
-	vend(I);
+	nir_otranspose(&nir);  // O[V+E]
+	if(nnverbose())  nirshow(&nir);
+	*onir = nir;
 }
 
 // ----------------------------------------------------------------------------------------------------------------------------# @blk1
-void namparse(i64 txtbdim,u8* txtdata, i64* on,u32** oNAM){  // n is the number of neurons, including input and output "layers"
-	sep(); print("\x1b[92m%c\x1b[0m\n", __func__);
+#if NAMP_SIMD
+// @meta  NAM parse whole rows, 32 characters at a time: each 32-byte load becomes a 32-bit row word via movemask (a '1' is a set bit), stored straight into NAM[i*C + j/32], and its set bits are the row's out-indices
+// a row must be exactly nc characters and a linefeed. stop at the 1st row that isn't (or that's cut short by the end of the file), or after nr rows, and leave it to the scalar path, which reports it
+// @ret  the number of rows parsed
+fdef i64 namp_rows_avx2(i64 txtbdim,u8* txtdata, i64 nc,i64 nr, u32* NAM,u64** oOoff,u32** oOidx){
+	u64* Ooff = *oOoff;
+	u32* Oidx = *oOidx;
+	i64  C    = divceilu(nc,32);
+	i64  i    = 0;
+	__m256i v1  = _mm256_set1_epi8(0x31);
+	__m256i vlf = _mm256_set1_epi8(0x0a);
+	for(; i<nr && (i+1)*(nc+1)<=txtbdim; ++i){
+		u8*  row = txtdata + i*(nc+1);
+		u32* w   = NAM + i*C;
+		if(row[nc]!=0x0a)  break;
+		i64 j=0, lf=0;
+		for(; j+32<=nc; j+=32){
+			__m256i c = _mm256_loadu_si256((__m256i*)(row+j));
+			lf       |= _mm256_movemask_epi8(_mm256_cmpeq_epi8(c,vlf));
+			w[j/32]   = _mm256_movemask_epi8(_mm256_cmpeq_epi8(c,v1));
+		}
+		if(j<nc){
+			u32 word = 0;
+			for(i64 k=j; k<nc; ++k){  word |= (u32)(row[k]==0x31) << (k-j);  lf |= row[k]==0x0a;  }
+			w[j/32] = word;
+		}
+		if(lf){  memset(w,0x00,Bsize(u32)*C);  break;  }
+		mfor(k,0,C)
+			for(u32 word=w[k]; word; word&=word-1)  vpush(Oidx, 32*k + __builtin_ctz(word));
+		vpush(Ooff,vidim(Oidx));
+	}
+	*oOoff=Ooff; *oOidx=Oidx;
+	return i;
+}
+#endif
+
+// @meta  the graph IR of a parsed NAM: the out-CSR (row i of the NAM holds the out-indices of neuron ni) is given, and the in-CSR is derived from it
+fdef nir_t namp_nir(i64 nc, u32* NAM, u64* Ooff,u32* Oidx){
+	i64   C   = divceilu(nc,32);
+	nir_t nir = {N:nc, E:vidim(Oidx), F:vini1(u8,nc+1), Ooff:Ooff, Oidx:Oidx};  // NAMs carry no activation fns, so every fj is 0 (identity)
+	memset(nir.F,0x00,nc);  vidim(nir.F)=nc;
+
+	// ----------------------------------------------------------------  the in-CSR comes from the transposed NAM: row j of NAMT holds the in-indices of neuron nj (in ascending order), and its popcount is the in-degree of nj
+	// the bit transpose costs O[V^2/32] no matter how many edges there are, so sparse NAMs (density under 1/16) are cheaper to transpose as an edge list
+	if(16*vidim(Oidx) < nc*nc){
+		nir_itranspose(&nir);  // O[V+E]
+		return nir;
+	}
+	u32* NAMT = malloc(mmax(Bsize(u32)*nc*C,1));  bitmat_tr(nc,NAM,NAMT);  // O[V^2/32]
+	u32* ideg = malloc(Bsize(u32)*mmax(nc,1));  bitmat_pop(nc,NAMT,ideg);
+	nir.Ioff = vini1(u64,nc+1);  vidim(nir.Ioff)=nc+1;
+	nir.Iidx = vini1(u32,nir.E+1);  vidim(nir.Iidx)=nir.E;
+	nir.Ioff[0] = 0;
+	mfor(j,0,nc)  nir.Ioff[j+1] = nir.Ioff[j] + ideg[j];
+	mfor(j,0,nc){
+		u32* idx = nir.Iidx + nir.Ioff[j];
+		mfor(k,0,C)
+			for(u32 word=NAMT[j*C+k]; word; word&=word-1)  *idx++ = 32*k + __builtin_ctz(word);
+	}
+	free(ideg);
+	free(NAMT);
+	return nir;
+}
+
+void namparse(i64 txtbdim,u8* txtdata, nir_t* onir,u32** oNAM){  // n is the number of neurons, including input and output "layers". @ret  the graph IR, with the out-CSR built while parsing (row i of the NAM holds the out-indices of neuron ni) and the in-CSR derived from it
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
 	u8* pos = txtdata;  // puts(txtdata);
 	i64 nr  = 0;       // nneurons across rows
 	i64 nc  = 0;       // nneurons across cols
-	while(*pos!=0x00 && *pos!=0x0a){
+	while(nc<txtbdim && *pos!=0x00 && *pos!=0x0a){
 		++pos; ++nc;
 	}
 
 	i64   nambdim = Bsize(u32)*nc*divceilu(nc,32);
 	u32*  NAM     = malloc(nambdim);  memset(NAM,0x00,nambdim);  // f32* P = malloc(Bsize(u32)*nc*nc); memset(P, 0x00,Bsize(u32)*nc*nc);  // we DO NOT want the full adjacency matrix, because, if there are 10^11 neurons, then the adjacency matrix has 10^22 neurons
-	u32** OPS     = vini1(u32*,nc);  // a vector of operations
-	print("\x1b[31m%,d \x1b[32m%,d  \x1b[34m%,d \x1b[0m%,d\n", nc,divceilu(nc,32), nc*nc, nambdim);
+	u32** OPS     = NULL;  // a vector of operations, only built for diagnostics
+	nnlogf("\x1b[31m%'ld \x1b[32m%'ld  \x1b[34m%'ld \x1b[0m%'ld\n", nc,(i64)divceilu(nc,32), nc*nc, nambdim);
 
-	mfor(i,0,nc)  vpush(OPS,vini(u32));
+	int verbose = nnverbose();
+	if(verbose){  OPS=vini1(u32*,nc);  mfor(i,0,nc)  vpush(OPS,vini(u32));  }
+	u64* Ooff = vini1(u64,nc+1);  vpush(Ooff,0);  // a vec of out-CSR offsets
+	u32* Oidx = vini(u32);                        // a vec of out-CSR indices
 	pos   = txtdata;
 	i64 C = divceilu(nc,32);
 	i64 i = 0;
 	i64 j = 0;
 	u8  val;
-	mfor(i,0,nc) printf("        n\x1b[32m%02x\x1b[0m",i);  putchar(0x0a);  // printf("   %c  ",0x61+i);  printf("   n%02x",i);
-	printf("n\x1b[32m%02x\x1b[0m",0);
-	while((val=*pos)!=0x00){
+#if NAMP_SIMD
+	if(!verbose){  // whole rows at a time: the rows that don't look like nc characters and a linefeed (and everything after them) are left to the scalar path
+		i = namp_rows_avx2(txtbdim,txtdata, nc,nc, NAM,&Ooff,&Oidx);
+		pos = txtdata + i*(nc+1);
+	}
+#endif
+	if(verbose){
+		mfor(i,0,nc) nnlogf("        n\x1b[32m%02lx\x1b[0m",i);  // printf("   %c  ",0x61+i);  printf("   n%02x",i);
+		nnlogf("\n");
+		nnlogf("n\x1b[32m%02x\x1b[0m",0);
+	}
+	while(pos<txtdata+txtbdim && (val=*pos)!=0x00){
 		++pos;
 		if(val==0x0a){
 			if(j!=nc){ fail("expected %d rows, but got %d", nc,j); exit(1); }
 			// else if(i!=nc-1)  printf("\n%c",0x61+i+1);
 			++i; j=0;
-			if(i<nc) printf("\nn\x1b[32m%02x\x1b[0m",i);  // BUG! @print() is bugged! try: @print("\n");
-			else     putchar(0x0a);
+			vpush(Ooff,vidim(Oidx));
+			if(i<nc) nnlogf("\nn\x1b[32m%02lx\x1b[0m",i);  // BUG! @print() is bugged! try: @print("\n");
+			else     nnlogf("\n");
 			continue;
-		}else if(val==0x31)  NAM[i*C + j/32] |= 1 << j%32; // print(" (%02x,%02x,%02x,%3d,%3d,%c,%c)\n", i,j,val, i*C + j/32,j%32, fmtu32bl(1 << j%32));
+		}
+		if(nc<=j || nc<=i){ fail("expected %d cols, but got more", nc); exit(1); }
+		if(val==0x31)  NAM[i*C + j/32] |= 1u << j%32; // print(" (%02x,%02x,%02x,%3d,%3d,%c,%c)\n", i,j,val, i*C + j/32,j%32, fmtu32bl(1 << j%32));
 
 		// char op0,op1,a,b;
 		// if(val==0x30)  op0=0x20, op1=0x5f, a=0x5f,   b=0x5f;
 		// else           op0=0x2b, op1=0x2a, a=0x61+i, b=0x61+j;
 		// printf(" %c%c%c%c%c", op0,a,op1, a,b);
 
-		if(val==0x30){  putchar(0x20);  mfor(i,0,1+1+2+1+1+2+2) putchar(0x5f);  }
-		else         {  printf(" \x1b[91m%c\x1b[0mn\x1b[32m%02x\x1b[91m%c\x1b[0mw\x1b[31m%02x\x1b[32m%02x\x1b[0m", 0x2b,i,0x2a, i,j);  }
+		if(verbose){
+			if(val==0x30){  nnlogf(" __________");  }
+			else         {  nnlogf(" \x1b[91m%c\x1b[0mn\x1b[32m%02lx\x1b[91m%c\x1b[0mw\x1b[31m%02lx\x1b[32m%02lx\x1b[0m", 0x2b,i,0x2a, i,j);  }
+		}
 
 		// if(val==0x31) printf("%d %d\n",i,j);
 
-		if(val==0x31){  // as you go over columns j, you should add it to the columns j
+		if(val==0x31)  vpush(Oidx,j);
+		if(verbose && val==0x31){  // as you go over columns j, you should add it to the columns j
 			vpush(OPS[j], OPADD);
 			vpush(OPS[j], i);
 			vpush(OPS[j], OPMUL);
@@ -338,38 +691,2801 @@ void namparse(i64 txtbdim,u8* txtdata, i64* on,u32** oNAM){  // n is the number
 	nr = i;
 	if(nr!=nc){ fail("\x1b[34mnr \x1b[0mnot equal to \x1b[34mnc\x1b[0m, \x1b[34mnr\x1b[0m: \x1b[31m%d\x1b[0m, \x1b[34mnc\x1b[0m: \x1b[31m%d\x1b[0m", nr,nc); exit(1); }
 
-	namshow(nc,NAM);
-	opsshow(OPS);
+	if(verbose){
+		namshow(nc,NAM);
+		opsshow(OPS);
+		vfor(OPS,it) vend(*it);
+		vend(OPS);
+	}
 
-	vfor(OPS,it) vend(*it);
-	vend(OPS);
-	*on=nc; *oNAM=NAM;
+	*onir = namp_nir(nc,NAM, Ooff,Oidx);
+	*oNAM = NAM;
 }
 
-// ----------------------------------------------------------------------------------------------------------------------------# @blk1
-fdefe int main(int nargs, char* args[]){
-	char* filepath = NALPATH;  if(1<nargs) filepath = args[1];
-	if(access(filepath,F_OK|R_OK)<0){ fail("can't open \x1b[92m%s\x1b[0m",filepath); exit(1); }
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  zst: NALs/NAMs, zstd-compressed
+/*
+a .nal.zst/.nam.zst is decompressed 1 fixed-size window at a time (see @zstream_t), and each window is parsed as soon as it's decompressed, so the text never exists in mem as a whole: only the IR does (and, for NAMs, the bit-packed NAM)
+a window is parsed up to its last linefeed, and the partial line after it comes back at the start of the next window. a line longer than a window doubles the window
+NAL windows go through the same (multithreaded) line parser as mmapped NALs. NAM windows go through the same row parser, but the -v trace and tables are per-file, so they're skipped
+*/
+#define NCC_ZWIN_BDIM  0x1000000  // zst parse: the decompression window, in bytes
+
+#if defined(M_ZSTD)
+fdef void nirparse_zst(char* path, i64 nthreads, nir_t* onir, i64* obdim){  // @ret  the graph IR, like @nirparse(), and the decompressed size in @obdim
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	zstream_t zs   = zstream_ini(path, NCC_ZWIN_BDIM);
+	nir_t     nir  = {0x00};
+	u64       line = 0;
+	int       head = 1;
+	for(i64 keep=0; zstream_next(&zs,keep); ){
+		u8* lf    = memrchr(zs.data,0x0a,zs.idim);
+		u8* tdata = zs.data;
+		i64 tbdim = zs.eof ? zs.idim : lf==NULL ? 0 : lf+1-zs.data;  // whole lines only, except in the last window
+		if(head){  // the header must be whole: the comment line (if any), and the N line
+			u8* hlf = memchr(zs.data,0x0a,zs.idim);
+			if(hlf!=NULL && *zs.data==0x25)  hlf = memchr(hlf+1,0x0a,zs.data+zs.idim-hlf-1);
+			if(hlf==NULL && !zs.eof){  keep=zs.idim;  continue;  }
+			nir.N = nirp_head(&tbdim,&tdata,&line);  head=0;
+			nir.F = vini1(u8,nir.N+1);  nir.Ioff = vini1(u64,nir.N+1);  nir.Iidx = vini(u32);
+		}
+		line += nirp_lines(tbdim,tdata,line, nthreads, &nir);
+		keep  = zs.data+zs.idim - (tdata+tbdim);
+	}
+	nnchk(head, "file is too small: %'ld bytes", zs.pos);
+	nnchk(nir.N!=vidim(nir.F), "N mismatch: %'ld %'ld", nir.N,vidim(nir.F));
+	vpush(nir.Ioff,nir.E);
+	*obdim = zs.pos;
+	zstream_end(&zs);
 
 	// ----------------------------------------------------------------
-	print("filepath \x1b[34m%c\x1b[0m\n", filepath);
-	nntut();
-
-	i64 filepath_bdim = strlen(filepath);
-	if(3<filepath_bdim && memcmp(".nam",filepath+filepath_bdim-4,4)==0){
-		file_t namfile = file_ini(filepath);
-		i64 n; u32* P=NULL;
-		namparse(namfile.bdim,namfile.data, &n,&P);
-		file_end(&namfile);
-		free(P);
-	}else{
-		file_t nirfile = file_ini(filepath);
-		i64 n;
-		nirparse(nirfile.bdim,nirfile.data, &n);
-		file_end(&nirfile);
+	nir_otranspose(&nir);  // O[V+E]
+	if(nnverbose())  nirshow(&nir);
+	*onir = nir;
+}
+
+fdef void namparse_zst(char* path, nir_t* onir,u32** oNAM, i64* obdim){  // @ret  the graph IR, like @namparse(), and the decompressed size in @obdim
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	zstream_t zs   = zstream_ini(path, NCC_ZWIN_BDIM);
+	i64       nc   = -1;  // nneurons across cols, from the 1st row
+	i64       C    = 0;
+	i64       i    = 0;   // rows so far
+	u32*      NAM  = NULL;
+	u64*      Ooff = NULL;
+	u32*      Oidx = NULL;
+	for(i64 keep=0; zstream_next(&zs,keep); ){
+		u8* pos = zs.data;
+		u8* end = zs.data+zs.idim;
+		if(nc<0){
+			u8* lf = memchr(zs.data,0x0a,zs.idim);
+			if(lf==NULL && !zs.eof){  keep=zs.idim;  continue;  }
+			nc   = lf==NULL ? zs.idim : lf-zs.data;
+			C    = divceilu(nc,32);
+			NAM  = malloc(mmax(Bsize(u32)*nc*C,1));  memset(NAM,0x00,Bsize(u32)*nc*C);
+			Ooff = vini1(u64,nc+1);  vpush(Ooff,0);
+			Oidx = vini(u32);
+			nnlogf("\x1b[31m%'ld \x1b[32m%'ld  \x1b[34m%'ld \x1b[0m%'ld\n", nc,C, nc*nc, Bsize(u32)*nc*C);
+		}
+#if NAMP_SIMD
+		i64 k = namp_rows_avx2(end-pos,pos, nc,nc-i, NAM+i*C,&Ooff,&Oidx);
+		pos += k*(nc+1);  i += k;
+#endif
+		for(u8* lf; pos<end && (lf=memchr(pos,0x0a,end-pos))!=NULL; pos=lf+1, ++i){  // whole rows the SIMD path left: the 1st bad row fails here
+			nnchk(nc<=i,      "row \x1b[34m%'ld\x1b[0m: expected %'ld rows, but got more", i,nc);
+			nnchk(lf-pos!=nc, "row \x1b[34m%'ld\x1b[0m: expected %'ld cols, but got %'ld", i,nc,lf-pos);
+			mfor(j,0,nc)
+				if(pos[j]==0x31){  NAM[i*C + j/32] |= 1u << j%32;  vpush(Oidx,j);  }
+			vpush(Ooff,vidim(Oidx));
+		}
+		nnchk(zs.eof && pos<end, "row \x1b[34m%'ld\x1b[0m: expected a linefeed", i);
+		keep = end-pos;
+	}
+	nnchk(i!=nc, "\x1b[34mnr \x1b[0mnot equal to \x1b[34mnc\x1b[0m, \x1b[34mnr\x1b[0m: \x1b[31m%'ld\x1b[0m, \x1b[34mnc\x1b[0m: \x1b[31m%'ld\x1b[0m", i,nc);
+	*obdim = zs.pos;
+	zstream_end(&zs);
+
+	if(nnverbose())  namshow(nc,NAM);
+	*onir = namp_nir(nc,NAM, Ooff,Oidx);
+	*oNAM = NAM;
+}
+#endif
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nel: the neural edge list
+/*
+an optional `%` comment line, an optional `N n` line, and then 1 line per edge, in any order: `i j [fj]`, in hex: ni is an in -neuron of nj (ie. the edge wij), and fj (optional) is the activation fn of nj
+w/o an N line, N is 1 + the largest neuron index. a neuron w/ no in -edges is an input neuron, and a neuron whose fj is never given gets the identity. if fj is given more than once, it must agree
+the in -indices of nj are in file order, so edge order is: neurons nj in ascending order, and, for each nj, its edges in file order
+*/
+#define nelpchk(line,st,...)  do{  if(st){ printf("\x1b[91mFAIL  \x1b[92m%s  \x1b[0mline \x1b[34m%'lu  \x1b[0m", __func__,line); printf(""__VA_ARGS__); putchar(0x0a); exit(1); }  }while(0)
+
+// @meta  NEL parse a hex number that must be there, w/o reading past the end
+#define nelpu64(tbdim,tdata,line)({                                                             \
+	nelpchk(line, tbdim<=0 || !isasciihex(*tdata), "expected an ascii hex byte");                   \
+	u64 _n=0;  while(0<tbdim && isasciihex(*tdata)){  _n = 0x10*_n + asciihex_to_u4(*tdata);  --tbdim; ++tdata;  }  \
+	_n;                                                                                            \
+})
+
+// @meta  NEL parse 1 pass over the edge lines:
+//   - the count pass (@Iidx is NULL) counts the in -degree of nj into @cnt[j+1], growing @cnt to fit the largest neuron index if N isn't known (@N<0)
+//   - the scatter pass writes each in -index to Iidx[pos[j]++], and each fj to F[j] (0xff is unset)
+// @ret  1 + the largest neuron index
+fdef i64 nelp_pass(i64 tbdim,u8* tdata,u64 line, i64 N, u64** cnt,i64* cntdim, u64* pos,u32* Iidx,u8* F){
+	i64 NI=0;
+	while(0<tbdim){
+		if(*tdata==0x0a){  --tbdim; ++tdata; ++line;  continue;  }  // empty line
+		u64 i = nelpu64(tbdim,tdata,line);  nelpchk(line, tbdim<=0 || *tdata!=0x20, "expected a space");  --tbdim; ++tdata;
+		u64 j = nelpu64(tbdim,tdata,line);
+		i64 f = -1;
+		if(0<tbdim && *tdata==0x20){  --tbdim; ++tdata;  f=nelpu64(tbdim,tdata,line);  }
+		nelpchk(line, 0<tbdim && *tdata!=0x0a, "expected a linefeed");
+		if(0<tbdim){  --tbdim; ++tdata;  }
+		nelpchk(line, 0<=N && (N<=i || N<=j), "neuron index \x1b[31m%02lx \x1b[0mout of range for N \x1b[34m%02lx\x1b[0m", mmax(i,j),N);
+		nelpchk(line, 0xfffffffeull<mmax(i,j),  "neuron index \x1b[31m%02lx \x1b[0mtoo large", mmax(i,j));
+		nelpchk(line, 0x06<f,                   "unknown activation fn code \x1b[35m%02lx \x1b[0mfor neuron n\x1b[32m%02lx\x1b[0m", f,j);
+		NI = mmax(NI,(i64)mmax(i,j)+1);
+		if(Iidx==NULL){
+			if(*cntdim<=j+1){  // only if N isn't known
+				i64 dim = mmax(2*(*cntdim), (i64)j+2);
+				*cnt = realloc(*cnt, Bsize(u64)*dim);  memset(*cnt+*cntdim,0x00,Bsize(u64)*(dim-*cntdim));  *cntdim=dim;
+			}
+			++(*cnt)[j+1];
+		}else{
+			Iidx[pos[j]++] = i;
+			if(0<=f){
+				nelpchk(line, F[j]!=0xff && F[j]!=f, "activation fn code \x1b[35m%02lx \x1b[0mfor neuron n\x1b[32m%02lx \x1b[0mdisagrees w/ an earlier \x1b[35m%02x\x1b[0m", f,j,F[j]);
+				F[j]=f;
+			}
+		}
+		++line;
+	}
+	return NI;
+}
+
+// @meta  NEL parse in 2 passes over the (mmapped) text: count the in -degrees, then scatter the in -indices into place. no edge is ever held in memory outside the in-CSR, so the edges never need sorting
+fdef void nelparse(i64 tbdim,u8* tdata, nir_t* onir){  // @ret  the graph IR, w/ the out-CSR derived from the in-CSR (caller must nir_end() it)
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	u64 line = 0;
+	if(0<tbdim && *tdata==0x25){
+		while(0<tbdim && *tdata!=0x0a){ --tbdim; ++tdata; }  // line0 is a comment
+		if(0<tbdim){ --tbdim; ++tdata; }  // skip 0x0a
+		++line;
+	}
+	i64 N = -1;
+	if(1<tbdim && (*tdata==0x4e || *tdata==0x6e) && tdata[1]==0x20){
+		tbdim-=2; tdata+=2;
+		N = nelpu64(tbdim,tdata,line);  nelpchk(line, 0<tbdim && *tdata!=0x0a, "expected a linefeed");
+		if(0<tbdim){ --tbdim; ++tdata; }
+		++line;
+		nnchk(0xffffffffll<N, "N too large: %'ld", N);
+	}
+
+	// ----------------------------------------------------------------  pass 0: count
+	i64  cntdim = mmax(N+1,1);
+	u64* cnt    = malloc(Bsize(u64)*cntdim);  memset(cnt,0x00,Bsize(u64)*cntdim);
+	i64  NI     = nelp_pass(tbdim,tdata,line, N, &cnt,&cntdim, NULL,NULL,NULL);  // O[bdim]
+	if(N<0)  N=NI;
+	nnlogf("\n\x1b[92mN \x1b[34m%'ld\x1b[0m\n",N);
+
+	nir_t nir = {N:N};
+	nir.Ioff  = vini1(u64,N+1);  vidim(nir.Ioff)=N+1;
+	nir.Ioff[0] = 0;
+	mfor(j,0,N)  nir.Ioff[j+1] = nir.Ioff[j] + cnt[j+1];
+	free(cnt);
+	nir.E     = nir.Ioff[N];
+	nir.Iidx  = vini1(u32,nir.E+1);  vidim(nir.Iidx)=nir.E;
+	nir.F     = vini1(u8, N+1);      vidim(nir.F)   =N;  memset(nir.F,0xff,N);
+
+	// ----------------------------------------------------------------  pass 1: scatter
+	u64* pos = malloc(Bsize(u64)*mmax(N,1));  memcpy(pos,nir.Ioff,Bsize(u64)*N);
+	nelp_pass(tbdim,tdata,line, N, NULL,NULL, pos,nir.Iidx,nir.F);  // O[bdim]
+	free(pos);
+	mfor(j,0,N)  if(nir.F[j]==0xff)  nir.F[j]=0;
+
+	// ----------------------------------------------------------------
+	nir_otranspose(&nir);  // O[V+E]
+	if(nnverbose())  nirshow(&nir);
+	*onir = nir;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nad: the architecture descriptor, ie. a net declared layer by layer, expanded straight into the graph IR
+/*
+1 layer per line, in evaluation order. numbers are decimal, and a % starts a comment. the neurons of each layer follow those of the previous layer, and (C,H,W) planes are row-major
+	in     NAME  C [H W]              C*H*W input neurons
+	dense  NAME  SRCS M F             M neurons, each reads every neuron of every SRC. a skip connection is just 1 more SRC
+	conv   NAME  SRC  C K S P F       C planes, each neuron reads a K x K window (stride S, zero padding P) over every plane of SRC
+	dwconv NAME  SRC  K S P F         1 plane per plane of SRC, each neuron reads a K x K window over its own plane
+	add    NAME  SRCS F               1 neuron per neuron of SRC (all SRCs have the same size), neuron k reads neuron k of every SRC, ie. a residual connection
+	rnn    NAME  SRC  M T F           T steps of M neurons, unrolled: step t reads slice t of SRC (SRC is T slices) and step t-1
+SRCS is a comma-separated list of SRC, and a SRC is a layer NAME or a NAME[a:b] range of its neurons (python slicing: a negative index counts from the end, and a missing one is the start/end)
+F is an activation fn, by name (identity sigmoid tanh relu silu gelu swish) or by code (0-6)
+the in -indices of each neuron are in SRC order, and ascending w/i each SRC, so dense and conv layers come out as exactly the blocks and conv planes that @nirblk_ini and @nirconv_ini look for
+*/
+#define NAD_LINE_BDIM_MAX  0x400
+#define NAD_ADD_SRCS_MAX   0x40
+#define NAD_IN      0
+#define NAD_DENSE   1
+#define NAD_CONV    2
+#define NAD_DWCONV  3
+#define NAD_ADD     4
+#define NAD_RNN     5
+
+tdef{
+	u32 off,dim;  // neurons n[off .. off+dim)
+	i64 lyr;      // the layer they belong to
+}nadsrc_t;
+
+tdef{
+	char      name[0x40];
+	u8        op;
+	u8        f;
+	u32       off,dim;  // neurons n[off .. off+dim)
+	u32       C,H,W;    // shape
+	u32       K,s,p;    // conv window, stride, padding
+	u32       T;        // rnn steps
+	nadsrc_t* srcs;     // vec of SRCs
+}nadlyr_t;
+
+#define nadchk(line,st,...)  do{  if(st){ printf("\x1b[91mFAIL  \x1b[92m%s  \x1b[0mline \x1b[34m%'ld  \x1b[0m", __func__,line); printf(""__VA_ARGS__); putchar(0x0a); exit(1); }  }while(0)
+
+fdef i64 nad_u32(i64 line, char* tok){  // @meta  a decimal u32 token, or fail
+	nadchk(line, tok==NULL, "expected a number");
+	char* end;  errno=0;  i64 x=strtoll(tok,&end,10);
+	nadchk(line, *end!=0x00 || errno!=0 || x<0 || 0xffffffffll<x, "bad number \x1b[31m%s\x1b[0m", tok);
+	return x;
+}
+
+fdef u8 nad_f(i64 line, char* tok){  // @meta  an activation fn token, or fail
+	static char* names[] = {"identity","sigmoid","tanh","relu","silu","gelu","swish"};
+	nadchk(line, tok==NULL, "expected an activation fn");
+	mfor(f,0,7)  if(strcmp(tok,names[f])==0)  return f;
+	nadchk(line, *tok<0x30 || 0x39<*tok, "unknown activation fn \x1b[31m%s\x1b[0m", tok);
+	i64 f = nad_u32(line,tok);  nadchk(line, 6<f, "unknown activation fn code \x1b[35m%ld\x1b[0m", f);
+	return f;
+}
+
+fdef nadsrc_t* nad_srcs(i64 line, char* tok, nadlyr_t* lyrs){  // @meta  a SRCS token, or fail. @ret  a vec of SRCs (caller must vend() it)
+	nadchk(line, tok==NULL, "expected a layer");
+	nadsrc_t* srcs = vini(nadsrc_t);
+	char* save;
+	for(char* src=strtok_r(tok,",",&save); src!=NULL; src=strtok_r(NULL,",",&save)){
+		char* br = strchr(src,0x5b);  // [
+		if(br!=NULL)  *br=0x00;
+		i64 l=vidim(lyrs)-1;  while(0<=l && strcmp(lyrs[l].name,src)!=0)  --l;  // the latest layer w/ that name
+		nadchk(line, l<0, "unknown layer \x1b[31m%s\x1b[0m", src);
+		i64 dim=lyrs[l].dim, a=0, b=dim;
+		if(br!=NULL){  // NAME[a:b]
+			char* colon = strchr(br+1,0x3a);  char* close = strchr(br+1,0x5d);
+			nadchk(line, colon==NULL || close==NULL || close<colon || close[1]!=0x00, "bad range for layer \x1b[31m%s\x1b[0m", src);
+			*colon=0x00;  *close=0x00;
+			if(br[1]   !=0x00){  char* end;  a=strtoll(br+1,   &end,10);  nadchk(line, *end!=0x00, "bad range start \x1b[31m%s\x1b[0m", br+1);     }
+			if(colon[1]!=0x00){  char* end;  b=strtoll(colon+1,&end,10);  nadchk(line, *end!=0x00, "bad range end \x1b[31m%s\x1b[0m",   colon+1);  }
+			if(a<0)  a+=dim;
+			if(b<0)  b+=dim;
+			nadchk(line, a<0 || dim<b || b<=a, "empty or out-of-range range \x1b[34m%ld:%ld \x1b[0mfor layer \x1b[31m%s \x1b[0mof \x1b[34m%'ld \x1b[0mneurons", a,b,src,dim);
+		}
+		vpush(srcs, ((nadsrc_t){off:lyrs[l].off+a, dim:b-a, lyr:l}));
+	}
+	return srcs;
+}
+
+// @meta  write the in -indices of the out-neuron at plane co, row oy, col ox of a conv layer to @iidx, in ascending order. @ret  their number
+fdef i64 nad_window(nadlyr_t* lyr, nadlyr_t* src, i64 co,i64 oy,i64 ox, u32* iidx){
+	i64 c0 = lyr->op==NAD_DWCONV ? co : 0;
+	i64 c1 = lyr->op==NAD_DWCONV ? co+1 : src->C;
+	i64 n  = 0;
+	mfor(c,c0,c1)  mfor(dy,0,lyr->K){
+		i64 iy = oy*lyr->s+dy-lyr->p;  if(iy<0 || src->H<=iy)  continue;
+		mfor(dx,0,lyr->K){
+			i64 ix = ox*lyr->s+dx-lyr->p;  if(ix<0 || src->W<=ix)  continue;
+			iidx[n++] = src->off + (c*src->H+iy)*src->W+ix;
+		}
+	}
+	return n;
+}
+
+fdef i64 nad_wdim(i64 odim, i64 idim, i64 K,i64 s,i64 p){  // @meta  the sum, over all out-rows (or out-cols) of a conv, of the number of in -rows (or in -cols) its window covers
+	i64 n=0;
+	mfor(o,0,odim)  n += mmin(o*s-p+K,idim) - mmax(o*s-p,0);
+	return n;
+}
+
+fdef i64 nad_edim(nadlyr_t* lyr, nadlyr_t* lyrs){  // @meta  the number of edges into a layer
+	i64 sdim=0;  if(lyr->srcs!=NULL)  mfor(q,0,vidim(lyr->srcs))  sdim += lyr->srcs[q].dim;
+	switch(lyr->op){
+		case NAD_DENSE:   return (i64)lyr->dim*sdim;
+		case NAD_ADD:     return (i64)lyr->dim*vidim(lyr->srcs);
+		case NAD_RNN:     return (i64)lyr->dim*(sdim/lyr->T) + (i64)(lyr->T-1)*lyr->H*lyr->H;
+		case NAD_CONV: case NAD_DWCONV:{
+			nadlyr_t* src = &lyrs[lyr->srcs[0].lyr];
+			return (i64)lyr->C * (lyr->op==NAD_CONV ? src->C : 1) * nad_wdim(lyr->H,src->H, lyr->K,lyr->s,lyr->p) * nad_wdim(lyr->W,src->W, lyr->K,lyr->s,lyr->p);
+		}
+	}
+	return 0;
+}
+
+// @meta  expand the out-CSR straight from the layers, in neuron order, instead of transposing the in-CSR: every out-list is written front to back, ie. no scatter. the out-indices of ni come from each layer that reads it, in layer order, so they're in ascending order, as if from @nir_transpose
+fdef void nad_oexpand(nadlyr_t* lyrs, nir_t* nir){
+	nir->Ooff = vini1(u64,nir->N+1);  vidim(nir->Ooff) = nir->N+1;
+	nir->Oidx = vini1(u32,nir->E+1);  vidim(nir->Oidx) = nir->E;
+	u32* odx  = nir->Oidx;
+	u32  jadd[NAD_ADD_SRCS_MAX];  // the out-indices of ni in an add layer, 1 per SRC that holds ni
+	mfor(i,0,nir->N){
+		nir->Ooff[i] = odx-nir->Oidx;
+		mfor(l,0,vidim(lyrs)){
+			nadlyr_t* lyr = &lyrs[l];
+			if(lyr->op==NAD_IN || lyr->off+lyr->dim<=i)  continue;  // a layer that's done w/ ni
+			switch(lyr->op){
+				case NAD_DENSE:{
+					i64 m=0;  mfor(q,0,vidim(lyr->srcs))  m += lyr->srcs[q].off<=i && i<lyr->srcs[q].off+lyr->srcs[q].dim;
+					if(m)  mfor(k,0,lyr->dim)  mfor(r,0,m)  *odx++ = lyr->off+k;
+				}break;
+				case NAD_ADD:{
+					i64 m=0;
+					mfor(q,0,vidim(lyr->srcs))
+						if(lyr->srcs[q].off<=i && i<lyr->srcs[q].off+lyr->srcs[q].dim){
+							u32 j = lyr->off + (i-lyr->srcs[q].off);
+							i64 r=m++;  while(0<r && j<jadd[r-1]){  jadd[r]=jadd[r-1];  --r;  }  jadd[r]=j;  // insertion sort
+						}
+					mfor(r,0,m)  *odx++ = jadd[r];
+				}break;
+				case NAD_CONV: case NAD_DWCONV:{
+					nadlyr_t* src = &lyrs[lyr->srcs[0].lyr];
+					if(i<src->off || src->off+src->dim<=i)  break;
+					i64 HW=(i64)src->H*src->W, c=(i-src->off)/HW, iy=((i-src->off)%HW)/src->W, ix=((i-src->off)%HW)%src->W;
+					i64 ylo=iy+lyr->p-lyr->K+1, xlo=ix+lyr->p-lyr->K+1;  // the out-rows (and cols) whose window covers row iy (and col ix)
+					ylo = ylo<=0 ? 0 : divceilu(ylo,lyr->s);  i64 yhi = mmin((iy+lyr->p)/lyr->s, (i64)lyr->H-1);
+					xlo = xlo<=0 ? 0 : divceilu(xlo,lyr->s);  i64 xhi = mmin((ix+lyr->p)/lyr->s, (i64)lyr->W-1);
+					i64 co0 = lyr->op==NAD_DWCONV ? c   : 0;
+					i64 co1 = lyr->op==NAD_DWCONV ? c+1 : lyr->C;
+					mfor(co,co0,co1)  for(i64 oy=ylo; oy<=yhi; ++oy)  for(i64 ox=xlo; ox<=xhi; ++ox)
+						*odx++ = lyr->off + (co*lyr->H+oy)*lyr->W+ox;
+				}break;
+				case NAD_RNN:{
+					i64 M=lyr->H, X=lyr->srcs[0].dim/lyr->T;
+					if(lyr->srcs[0].off<=i && i<lyr->srcs[0].off+lyr->srcs[0].dim){  i64 t=(i-lyr->srcs[0].off)/X;    mfor(k,0,M)  *odx++ = lyr->off+t*M+k;  }  // x_t feeds step t
+					if(lyr->off<=i && i+M<lyr->off+lyr->dim){                         i64 t=(i-lyr->off)/M;              mfor(k,0,M)  *odx++ = lyr->off+(t+1)*M+k;  }  // step t feeds step t+1
+				}break;
+			}
+		}
+	}
+	nir->Ooff[nir->N] = odx-nir->Oidx;
+	nnchk(odx-nir->Oidx!=nir->E, "expanded \x1b[34m%'ld \x1b[0mout-edges, expected \x1b[34m%'ld\x1b[0m", odx-nir->Oidx,nir->E);
+}
+
+// @meta  parse an architecture descriptor and expand it into the in-CSR: O[text] to parse, then O[V+E] to expand, neuron by neuron, w/o ever writing the graph as text
+fdef void nadparse(i64 tbdim,u8* tdata, nir_t* onir){  // @ret  the graph IR, w/ the out-CSR derived from the in-CSR (caller must nir_end() it)
+	nnlogf("\n"M_SEP); nnlogf("\x1b[92m%s\x1b[0m\n", __func__);
+	nadlyr_t* lyrs = vini(nadlyr_t);
+	i64       N    = 0;
+	char      buf[NAD_LINE_BDIM_MAX];
+	u8*       end  = tdata+tbdim;
+	for(i64 line=0; tdata<end; ++line){
+		u8* lf = memchr(tdata,0x0a,end-tdata);  if(lf==NULL)  lf=end;
+		i64 bdim = lf-tdata;
+		nadchk(line, NAD_LINE_BDIM_MAX<=bdim, "line too long");
+		memcpy(buf,tdata,bdim);  buf[bdim]=0x00;
+		tdata = lf+(lf<end);
+		char* pct = strchr(buf,0x25);  if(pct!=NULL)  *pct=0x00;  // strip the comment
+
+		char* save;
+		char* op = strtok_r(buf," \t\r",&save);  if(op==NULL)  continue;
+		char* name = strtok_r(NULL," \t\r",&save);
+		nadchk(line, name==NULL,                "expected a layer name after \x1b[31m%s\x1b[0m", op);
+		nadchk(line, sizeof(((nadlyr_t*)0)->name)<=strlen(name), "layer name too long");
+		nadchk(line, strpbrk(name,",[]:")!=NULL, "layer names can't contain any of ,[]:");
+		nadlyr_t lyr = {off:N, C:1,H:1,W:1};
+		strcpy(lyr.name,name);
+		#define nadtok()  strtok_r(NULL," \t\r",&save)
+		if(strcmp(op,"in")==0){
+			lyr.op=NAD_IN;  lyr.C=nad_u32(line,nadtok());
+			char* h=nadtok();  if(h!=NULL){  lyr.H=nad_u32(line,h);  lyr.W=nad_u32(line,nadtok());  }
+		}else if(strcmp(op,"dense")==0){
+			lyr.op=NAD_DENSE;  lyr.srcs=nad_srcs(line,nadtok(),lyrs);  lyr.C=nad_u32(line,nadtok());  lyr.f=nad_f(line,nadtok());
+		}else if(strcmp(op,"conv")==0 || strcmp(op,"dwconv")==0){
+			lyr.op = op[0]==0x63 ? NAD_CONV : NAD_DWCONV;
+			lyr.srcs=nad_srcs(line,nadtok(),lyrs);
+			nadchk(line, vidim(lyr.srcs)!=1 || lyr.srcs[0].dim!=lyrs[lyr.srcs[0].lyr].dim, "a conv reads exactly 1 whole layer");
+			nadlyr_t* src = &lyrs[lyr.srcs[0].lyr];
+			if(lyr.op==NAD_CONV)  lyr.C=nad_u32(line,nadtok());
+			else                  lyr.C=src->C;
+			lyr.K=nad_u32(line,nadtok());  lyr.s=nad_u32(line,nadtok());  lyr.p=nad_u32(line,nadtok());  lyr.f=nad_f(line,nadtok());
+			nadchk(line, lyr.K==0 || lyr.s==0 || lyr.K<=lyr.p, "bad conv: K \x1b[34m%u \x1b[0mS \x1b[34m%u \x1b[0mP \x1b[34m%u\x1b[0m", lyr.K,lyr.s,lyr.p);
+			i64 Hp=(i64)src->H+2*(i64)lyr.p, Wp=(i64)src->W+2*(i64)lyr.p;  // padded, in i64: 2 u32's overflow a u32
+			nadchk(line, Hp<lyr.K || Wp<lyr.K, "the window doesn't fit in \x1b[34m%u \x1b[0mx \x1b[34m%u\x1b[0m", src->H,src->W);
+			nadchk(line, 0xffffffffll<(Hp-lyr.K)/lyr.s+1 || 0xffffffffll<(Wp-lyr.K)/lyr.s+1, "the output of the conv is too large");
+			lyr.H = (Hp-lyr.K)/lyr.s+1;
+			lyr.W = (Wp-lyr.K)/lyr.s+1;
+		}else if(strcmp(op,"add")==0){
+			lyr.op=NAD_ADD;  lyr.srcs=nad_srcs(line,nadtok(),lyrs);  lyr.f=nad_f(line,nadtok());
+			nadchk(line, NAD_ADD_SRCS_MAX<vidim(lyr.srcs), "add: more than \x1b[34m%d \x1b[0mSRCs", NAD_ADD_SRCS_MAX);
+			nadlyr_t* src = &lyrs[lyr.srcs[0].lyr];
+			if(lyr.srcs[0].dim==src->dim){  lyr.C=src->C;  lyr.H=src->H;  lyr.W=src->W;  }  // keep the shape of a whole layer
+			else                             lyr.C=lyr.srcs[0].dim;
+			mfor(k,1,vidim(lyr.srcs))  nadchk(line, lyr.srcs[k].dim!=lyr.srcs[0].dim, "add: SRC \x1b[34m%ld \x1b[0mhas \x1b[34m%'u \x1b[0mneurons, not \x1b[34m%'u\x1b[0m", k,lyr.srcs[k].dim,lyr.srcs[0].dim);
+		}else if(strcmp(op,"rnn")==0){
+			lyr.op=NAD_RNN;  lyr.srcs=nad_srcs(line,nadtok(),lyrs);  lyr.H=nad_u32(line,nadtok());  lyr.T=nad_u32(line,nadtok());  lyr.f=nad_f(line,nadtok());
+			nadchk(line, vidim(lyr.srcs)!=1 || lyr.T==0 || lyr.srcs[0].dim%lyr.T, "an rnn reads exactly 1 SRC, of T slices");
+			lyr.C = lyr.T;  // T steps (planes) of M neurons
+		}else{
+			nadchk(line, 1, "unknown layer type \x1b[31m%s\x1b[0m", op);
+		}
+		nadchk(line, nadtok()!=NULL, "trailing tokens");
+		#undef nadtok
+		u64 CH  = (u64)lyr.C*lyr.H;                // < 2**64, and so is CH*W if CH fits a u32
+		u64 dim = CH<=0xffffffffull ? CH*lyr.W : ~0ull;  // and, if it doesn't, the layer is too large anyway
+		nadchk(line, 0xffffffffull<dim,  "layer too large: \x1b[34m%'u \x1b[0mx \x1b[34m%'u \x1b[0mx \x1b[34m%'u \x1b[0mneurons", lyr.C,lyr.H,lyr.W);
+		nadchk(line, dim==0,             "empty layer");
+		nadchk(line, 0xffffffffll<N+(i64)dim, "N too large: \x1b[34m%'ld\x1b[0m", N+(i64)dim);
+		lyr.dim = dim;
+		N += lyr.dim;
+		vpush(lyrs,lyr);
+	}
+	nnchk(vidim(lyrs)==0, "no layers");
+
+	// ----------------------------------------------------------------  expand
+	i64 E=0;  mfor(l,0,vidim(lyrs))  E += nad_edim(&lyrs[l],lyrs);
+	nir_t nir  = {N:N, E:E};
+	nir.F      = vini1(u8, N+1);  vidim(nir.F)   =N;
+	nir.Ioff   = vini1(u64,N+1);  vidim(nir.Ioff)=N+1;
+	nir.Iidx   = vini1(u32,E+1);  vidim(nir.Iidx)=E;
+	u32*  idx  = nir.Iidx;
+	mfor(l,0,vidim(lyrs)){
+		nadlyr_t* lyr = &lyrs[l];
+		nnlogf("\x1b[92m%-6s \x1b[33m%-16s \x1b[0mn\x1b[32m%02x\x1b[0m..n\x1b[32m%02x  \x1b[34m%'u \x1b[0mx \x1b[34m%'u \x1b[0mx \x1b[34m%'u\x1b[0m\n", (char*[]){"in","dense","conv","dwconv","add","rnn"}[lyr->op], lyr->name, lyr->off,lyr->off+lyr->dim-1, lyr->C,lyr->H,lyr->W);
+		mfor(k,0,lyr->dim){
+			i64 j = lyr->off+k;
+			nir.F[j]=lyr->f;  nir.Ioff[j]=idx-nir.Iidx;
+			switch(lyr->op){
+				case NAD_DENSE:
+					mfor(q,0,vidim(lyr->srcs))  mfor(i,0,lyr->srcs[q].dim)  *idx++ = lyr->srcs[q].off+i;
+					break;
+				case NAD_CONV: case NAD_DWCONV:{
+					i64 HW=(i64)lyr->H*lyr->W;
+					idx += nad_window(lyr,&lyrs[lyr->srcs[0].lyr], k/HW,(k%HW)/lyr->W,k%lyr->W, idx);
+				}break;
+				case NAD_ADD:
+					mfor(q,0,vidim(lyr->srcs))  *idx++ = lyr->srcs[q].off+k;
+					break;
+				case NAD_RNN:{
+					i64 M=lyr->H, t=k/M, X=lyr->srcs[0].dim/lyr->T;
+					mfor(i,0,X)  *idx++ = lyr->srcs[0].off+t*X+i;
+					if(0<t)  mfor(i,0,M)  *idx++ = lyr->off+(t-1)*M+i;
+				}break;
+			}
+		}
 	}
+	nnchk(idx-nir.Iidx!=E, "expanded \x1b[34m%'ld \x1b[0medges, expected \x1b[34m%'ld\x1b[0m", idx-nir.Iidx,E);
+	nir.Ioff[N]=E;
+	nad_oexpand(lyrs,&nir);  // O[V+E]
+	mfor(l,0,vidim(lyrs))  if(lyrs[l].srcs!=NULL)  vend(lyrs[l].srcs);
+	vend(lyrs);
 
 	// ----------------------------------------------------------------
+	if(nnverbose())  nirshow(&nir);
+	*onir = nir;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nab: the binary NAL, an mmap-able container for the graph IR
+/*
+a .nab file is a 128-byte header followed by the 5 arrays of the graph IR, each at a multiple of 64 bytes (zero padding in between), little-endian:
+	F[N] u8, Ioff[N+1] u64, Iidx[E] u32, Ooff[N+1] u64, Oidx[E] u32
+loading a .nab is an mmap, the header checks, and an O[N+E] check of the CSR (offsets from 0 to E, never down, and indices < N), so a corrupt body fails at load time and not as an out-of-bounds read later on: the arrays are used in place. the header carries
+	- hchk: a checksum of the header itself, always checked
+	- chk:  a checksum of everything after the header. it's checked w/ -c, since it hashes every byte (the CSR check reads the arrays, but doesn't hash them)
+	- the size and mtime of the .nal/.nam it was converted from. if that file still sits next to the .nab (same stem) and it changed, the .nab is stale
+*/
+#define NAB_MAGIC    0x0062616e2e63636eull  // "ncc.nab\0"
+#define NAB_VERSION  1
+#define NAB_ALIGN    64
+tdef{
+	u64 magic;                                 // NAB_MAGIC
+	u64 version;                               // NAB_VERSION
+	i64 bdim;                                  // file size
+	i64 N,E;
+	u64 Fpos,Ioffpos,Iidxpos,Ooffpos,Oidxpos;  // byte offsets of the arrays
+	i64 src_bdim,src_mtime;                    // size and mtime (ns) of the source .nal/.nam, at conversion time
+	u8  src_ext[8];                            // extension of the source, ie. ".nal" or ".nam", or empty
+	u64 chk;                                   // xxh64 of the bytes after the header
+	u64 hchk;                                  // xxh64 of the header bytes before this field
+	u64 pad[1];
+}nab_t;
+
+// @meta  xxh64, by Yann Collet  https://github.com/Cyan4973/xxHash
+#define XXH_P1  0x9e3779b185ebca87ull
+#define XXH_P2  0xc2b2ae3d27d4eb4full
+#define XXH_P3  0x165667b19e3779f9ull
+#define XXH_P4  0x85ebca77c2b2ae63ull
+#define XXH_P5  0x27d4eb2f165667c5ull
+#define xxh_rotl(X,R)      (((X)<<(R)) | ((X)>>(64-(R))))
+#define xxh_round(ACC,X)   (xxh_rotl((ACC) + (X)*XXH_P2, 31) * XXH_P1)
+#define xxh_merge(ACC,X)   (((ACC) ^ xxh_round(0,(X)))*XXH_P1 + XXH_P4)
+fdef u64 xxh64(void* data,i64 bdim, u64 seed){
+	u8* p   = (u8*)data;
+	u8* end = p + bdim;
+	u64 h;
+	if(32<=bdim){
+		u64 v0=seed+XXH_P1+XXH_P2, v1=seed+XXH_P2, v2=seed, v3=seed-XXH_P1, x;
+		for(; p+32<=end; p+=32){
+			memcpy(&x,p+ 0,8); v0=xxh_round(v0,x);
+			memcpy(&x,p+ 8,8); v1=xxh_round(v1,x);
+			memcpy(&x,p+16,8); v2=xxh_round(v2,x);
+			memcpy(&x,p+24,8); v3=xxh_round(v3,x);
+		}
+		h = xxh_rotl(v0,1) + xxh_rotl(v1,7) + xxh_rotl(v2,12) + xxh_rotl(v3,18);
+		h = xxh_merge(h,v0); h = xxh_merge(h,v1); h = xxh_merge(h,v2); h = xxh_merge(h,v3);
+	}else  h = seed + XXH_P5;
+	h += (u64)bdim;
+	for(; p+8<=end; p+=8){  u64 x; memcpy(&x,p,8);  h ^= xxh_round(0,x);  h = xxh_rotl(h,27)*XXH_P1 + XXH_P4;  }
+	for(; p+4<=end; p+=4){  u32 x; memcpy(&x,p,4);  h ^= (u64)x*XXH_P1;   h = xxh_rotl(h,23)*XXH_P2 + XXH_P3;  }
+	for(; p  < end; p+=1){                         h ^= (u64)*p*XXH_P5;  h = xxh_rotl(h,11)*XXH_P1;            }
+	h ^= h>>33; h *= XXH_P2;
+	h ^= h>>29; h *= XXH_P3;
+	h ^= h>>32;
+	return h;
+}
+
+// @meta  the source of a .nab, ie. the .nal/.nam it was converted from, if it sits next to it (same stem), or NULL. caller must free() it
+fdef char* nab_srcpath(char* nabpath, nab_t* h){
+	i64   bdim = strlen(nabpath);
+	if(bdim<4 || !path_endswith(nabpath,".nab") || h->src_ext[0]!=0x2e || h->src_ext[4]!=0x00)  return NULL;
+	char* path = malloc(bdim+1);
+	memcpy(path,nabpath,bdim+1);
+	memcpy(path+bdim-4,h->src_ext,4);
+	if(access(path,F_OK)==0)  return path;
+	free(path);
+	return NULL;
+}
+
+// @meta  write @bdim bytes to @path, in as many write() calls as it takes
+fdef void file_save(char* path, void* data, u64 bdim){
+	int fd = open(path, O_WRONLY|O_CREAT|O_TRUNC, 0644);  nnchk(fd<0, "can't open \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+	for(u64 pos=0; pos<bdim;){
+		i64 st = write(fd, (u8*)data+pos, bdim-pos);  nnchk(st<=0, "can't write \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+		pos += st;
+	}
+	nnchk(close(fd)<0, "can't write \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+}
+
+fdef void nabsave(char* path, nir_t* nir, char* srcpath){
+	nab_t h    = {magic:NAB_MAGIC, version:NAB_VERSION, N:nir->N, E:nir->E};
+	u64   bdim = sizeof(nab_t);
+	h.Fpos    = bdim;  bdim = divceilu(bdim + Bsize(u8) *nir->N,    NAB_ALIGN)*NAB_ALIGN;
+	h.Ioffpos = bdim;  bdim = divceilu(bdim + Bsize(u64)*(nir->N+1),NAB_ALIGN)*NAB_ALIGN;
+	h.Iidxpos = bdim;  bdim = divceilu(bdim + Bsize(u32)*nir->E,    NAB_ALIGN)*NAB_ALIGN;
+	h.Ooffpos = bdim;  bdim = divceilu(bdim + Bsize(u64)*(nir->N+1),NAB_ALIGN)*NAB_ALIGN;
+	h.Oidxpos = bdim;  bdim = divceilu(bdim + Bsize(u32)*nir->E,    NAB_ALIGN)*NAB_ALIGN;
+	h.bdim    = bdim;
+	struct stat fs;
+	if(srcpath!=NULL && stat(srcpath,&fs)==0){  h.src_bdim=fs.st_size;  h.src_mtime=fs.st_mtim.tv_sec*1000000000ll + fs.st_mtim.tv_nsec;  }
+	if(srcpath!=NULL && (path_endswith(srcpath,".nal") || path_endswith(srcpath,".nam")))  memcpy(h.src_ext, srcpath+strlen(srcpath)-4,4);
+
+	// ----------------------------------------------------------------  build the file in memory (it's about the size of the IR), then checksum and write it in 1 go
+	u8* data = aligned_alloc(NAB_ALIGN,bdim);  memset(data,0x00,bdim);
+	memcpy(data+h.Fpos,    nir->F,    Bsize(u8) *nir->N);
+	memcpy(data+h.Ioffpos, nir->Ioff, Bsize(u64)*(nir->N+1));
+	memcpy(data+h.Iidxpos, nir->Iidx, Bsize(u32)*nir->E);
+	memcpy(data+h.Ooffpos, nir->Ooff, Bsize(u64)*(nir->N+1));
+	memcpy(data+h.Oidxpos, nir->Oidx, Bsize(u32)*nir->E);
+	h.chk  = xxh64(data+sizeof(nab_t), bdim-sizeof(nab_t), NAB_MAGIC);
+	h.hchk = xxh64(&h, offsetof(nab_t,hchk), NAB_MAGIC);
+	memcpy(data,&h,sizeof(nab_t));
+
+	file_save(path, data,bdim);
+	free(data);
+	nnlogf("\x1b[92mnabsave  \x1b[0mN \x1b[34m%'ld  \x1b[0mE \x1b[34m%'ld  \x1b[0mbdim \x1b[34m%'lu  \x1b[92m%s\x1b[0m\n", nir->N,nir->E,bdim, path);
+}
+
+// @meta  check that the CSR @off/@idx of a .nab is well-formed: @off goes from 0 to @E and never down, and every index is a neuron. w/o it, a corrupt body (the checksum is opt-in) indexes out of bounds later on
+fdef void nab_chkcsr(char* path, i64 N, i64 E, u64* off, u32* idx, char* name){
+	nnchk(off[0]!=0 || off[N]!=(u64)E, "\x1b[92m%s \x1b[0mhas a corrupt %s-index: its offsets span \x1b[34m%'lu\x1b[0m..\x1b[34m%'lu\x1b[0m, expected 0..\x1b[34m%'ld\x1b[0m", path,name, off[0],off[N], E);
+	mfor(j,0,N)  nnchk(off[j+1]<off[j], "\x1b[92m%s \x1b[0mhas a corrupt %s-index: the offsets of neuron n\x1b[32m%02lx \x1b[0mgo down", path,name, j);
+	mfor(e,0,E)  nnchk(N<=idx[e], "\x1b[92m%s \x1b[0mhas a corrupt %s-index: edge \x1b[34m%'ld \x1b[0mpoints to n\x1b[32m%02x\x1b[0m, past the last neuron, n\x1b[32m%02lx\x1b[0m", path,name, e,idx[e],N-1);
+}
+
+// @meta  take ownership of @file (an mmapped .nab) and point the IR's arrays into it. it checks the CSR (see @nab_chkcsr) and the activation fn codes in O[N+E], and, if @verify, the checksum of the whole file
+fdef void nabload(file_t file, int verify, nir_t* onir){
+	nab_t* h = (nab_t*)file.data;
+	nnchk(file.bdim<(i64)sizeof(nab_t),                          "\x1b[92m%s \x1b[0mis too small to be a .nab: %'ld bytes", file.path,file.bdim);
+	nnchk(h->magic!=NAB_MAGIC,                                  "\x1b[92m%s \x1b[0mis not a .nab", file.path);
+	nnchk(h->version!=NAB_VERSION,                              "\x1b[92m%s \x1b[0mhas version %lu, expected %d", file.path,h->version,NAB_VERSION);
+	nnchk(h->hchk!=xxh64(h,offsetof(nab_t,hchk),NAB_MAGIC),     "\x1b[92m%s \x1b[0mhas a corrupt header", file.path);
+	nnchk(h->bdim!=file.bdim,                                   "\x1b[92m%s \x1b[0mis truncated: %'ld bytes, expected %'ld", file.path,file.bdim,h->bdim);
+	nnchk(h->N<0 || 0xffffffffll<h->N || h->E<0, "\x1b[92m%s \x1b[0mhas a bad N/E", file.path);
+	u64 ends[] = {h->Fpos+Bsize(u8)*h->N, h->Ioffpos+Bsize(u64)*(h->N+1), h->Iidxpos+Bsize(u32)*h->E, h->Ooffpos+Bsize(u64)*(h->N+1), h->Oidxpos+Bsize(u32)*h->E};
+	u64 poss[] = {h->Fpos, h->Ioffpos, h->Iidxpos, h->Ooffpos, h->Oidxpos};
+	mfor(k,0,5)  nnchk(poss[k]%NAB_ALIGN!=0 || poss[k]<sizeof(nab_t) || ends[k]<poss[k] || h->bdim<ends[k], "\x1b[92m%s \x1b[0mhas a bad array offset", file.path);
+	if(verify)  nnchk(h->chk!=xxh64(file.data+sizeof(nab_t),file.bdim-sizeof(nab_t),NAB_MAGIC), "\x1b[92m%s \x1b[0mfails its checksum", file.path);
+	nab_chkcsr(file.path, h->N,h->E, (u64*)(file.data+h->Ioffpos),(u32*)(file.data+h->Iidxpos), "in");
+	nab_chkcsr(file.path, h->N,h->E, (u64*)(file.data+h->Ooffpos),(u32*)(file.data+h->Oidxpos), "out");
+	mfor(j,0,h->N)  nnchk(0x06<file.data[h->Fpos+j], "\x1b[92m%s \x1b[0mhas an unknown activation fn code \x1b[35m%02x \x1b[0mfor neuron n\x1b[32m%02lx\x1b[0m", file.path, file.data[h->Fpos+j],j);
+
+	char* srcpath = nab_srcpath(file.path,h);
+	struct stat fs;
+	if(srcpath!=NULL && stat(srcpath,&fs)==0)
+		nnchk(fs.st_size!=h->src_bdim || fs.st_mtim.tv_sec*1000000000ll+fs.st_mtim.tv_nsec!=h->src_mtime, "\x1b[92m%s \x1b[0mis stale: \x1b[92m%s \x1b[0mchanged since it was converted", file.path,srcpath);
+	free(srcpath);
+
+	*onir = (nir_t){N:h->N, E:h->E, F:file.data+h->Fpos, Ioff:(u64*)(file.data+h->Ioffpos), Iidx:(u32*)(file.data+h->Iidxpos), Ooff:(u64*)(file.data+h->Ooffpos), Oidx:(u32*)(file.data+h->Oidxpos), nab:file};
+	if(nnverbose())  nirshow(onir);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirlvl: the topological levels (wavefronts) of the graph
+/*
+the level of neuron nj is the length of the longest path from an input neuron to nj: input neurons (no in-indices) are level 0, and every other neuron is 1 + the max level of its in -neurons
+the neurons of a level don't depend on each other, so a whole level can be evaluated at once (across cores, or across SIMD lanes). L, the number of levels, is the length of the critical path (in neurons)
+the neurons of level l are idx[off[l] .. off[l+1]), in ascending order
+*/
+tdef{
+	i64  L;    // number of levels
+	u32* lvl;  // vec of levels, [N]: the level of neuron nj
+	u64* off;  // vec of level offsets, [L+1]
+	u32* idx;  // vec of neuron indices, [N], grouped by level
+}nirlvl_t;
+
+fdef void nirlvl_end(nirlvl_t* lvl){
+	if(lvl==NULL) return;
+	if(lvl->lvl!=NULL) vend(lvl->lvl);
+	if(lvl->off!=NULL) vend(lvl->off);
+	if(lvl->idx!=NULL) vend(lvl->idx);
+	*lvl=(nirlvl_t){0x00};
+}
+
+// @meta  O[N+L] group the neurons by level, given the levels @lvl (a vec of N items, which @olvl takes over) and their number @L: a counting sort
+fdef void nirlvl_idx(i64 N, u32* lvl, i64 L, nirlvl_t* olvl){
+	u64* off = vini1(u64,L+1);  vidim(off)=L+1;
+	u32* idx = vini1(u32,N+1);  vidim(idx)=N;
+	memset(off,0x00,Bsize(u64)*(L+1));
+	mfor(j,0,N)  ++off[lvl[j]+1];
+	mfor(l,0,L)  off[l+1] += off[l];
+	u64* pos = malloc(Bsize(u64)*mmax(L,1));  memcpy(pos,off,Bsize(u64)*L);
+	mfor(j,0,N)  idx[pos[lvl[j]]++] = j;
+	free(pos);
+	*olvl = (nirlvl_t){L:L, lvl:lvl, off:off, idx:idx};
+}
+
+// @meta  O[V+E] levelization: Kahn's algorithm over the out-CSR (a neuron is ready once all its in -neurons are), then a counting sort of the neurons by level. fail if the graph has a cycle, and show one
+fdef void nirlvl_ini(nir_t* nir, nirlvl_t* olvl){
+	i64  N   = nir->N;
+	u32* deg = malloc(Bsize(u32)*mmax(N,1));  // in-degrees still pending
+	u32* q   = malloc(Bsize(u32)*mmax(N,1));  // the ready queue, ie. a topological order
+	u32* lvl = vini1(u32,N+1);  vidim(lvl)=N;
+	i64  qn=0, L=0;
+	mfor(j,0,N){
+		deg[j]=nir_idim(nir,j);  lvl[j]=0;
+		if(deg[j]==0)  q[qn++]=j;
+	}
+	mfor(h,0,qn){  // @q grows while we walk it
+		u32 j=q[h];  L=mmax(L,lvl[j]+1);
+		for(u64 o=nir->Ooff[j]; o<nir->Ooff[j+1]; ++o){
+			u32 k=nir->Oidx[o];
+			lvl[k] = mmax(lvl[k],lvl[j]+1);
+			if(--deg[k]==0)  q[qn++]=k;
+		}
+	}
+
+	// ----------------------------------------------------------------  every neuron left over has a left-over in -neuron, so walking back through left-over in -neurons must run into a cycle
+	if(qn<N){
+		u32 j=0;  while(deg[j]==0) ++j;
+		for(;;){  // mark the walk in @lvl, which is dead anyway
+			lvl[j]=0xffffffff;
+			u64 e=nir->Ioff[j];  while(deg[nir->Iidx[e]]==0) ++e;
+			j=nir->Iidx[e];
+			if(lvl[j]==0xffffffff) break;
+		}
+		char cyc[0x100];  i64 cycn=0, cycbdim=0;  u32 i=j;
+		do{
+			if(cycn<8)  cycbdim += snprintf(cyc+cycbdim,sizeof(cyc)-cycbdim, "n\x1b[32m%02x \x1b[91m<- \x1b[0m",i);
+			u64 e=nir->Ioff[i];  while(deg[nir->Iidx[e]]==0) ++e;
+			i=nir->Iidx[e];  ++cycn;
+		}while(i!=j);
+		nnchk(1, "the graph has a cycle of \x1b[34m%'ld \x1b[0mneurons (\x1b[34m%'ld \x1b[0mneurons are on or behind a cycle): %s%s\x1b[32m%02x\x1b[0m", cycn,N-qn, cyc,cycn<=8?"n":"... n",j);
+	}
+	free(q);
+	free(deg);
+	nirlvl_idx(N, lvl,L, olvl);
+}
+
+fdef void nirlvlshow(nirlvl_t* lvl){
+	i64 W=0;  mfor(l,0,lvl->L)  W=mmax(W,lvl->off[l+1]-lvl->off[l]);
+	nnlogf("\n\x1b[92mlevels  \x1b[0mL \x1b[34m%'ld  \x1b[0mmax width \x1b[34m%'ld\x1b[0m\n", lvl->L,W);
+	mfor(l,0,lvl->L)  nnlogf("\x1b[92mL\x1b[32m%02lx\x1b[91m: \x1b[34m%'lu\x1b[0m\n", l,lvl->off[l+1]-lvl->off[l]);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirblk: dense bipartite blocks, ie. runs of neurons that are fully connected to the same run of in -neurons
+/*
+a block is a run of m neurons nj .. nj+m-1 w/ the same activation fn whose in -indices are all exactly i .. i+k-1, in ascending order. since the edges of a neuron are contiguous in edge order, the weights of a block are already a packed, row-major m x k matrix at w[e], so a block is a single GEMV: n[j .. j+m) = f(W * n[i .. i+k))
+all neurons of a block share a level, so a block can be evaluated in place of its 1st neuron
+*/
+#define NIRBLK_MDIM_MIN  2  // the smallest run of neurons worth a GEMV
+
+tdef{
+	u32 j,m;  // out-neurons nj .. nj+m-1, ie. the rows
+	u32 i,k;  // in -neurons ni .. ni+k-1, ie. the cols
+	u64 e;    // the 1st weight
+}nirblk_t;
+
+fdef int nirblk_contiguous(nir_t* nir, i64 j){  // @meta  are the in -indices of neuron nj a run of consecutive neurons, in ascending order?
+	u64 e0=nir->Ioff[j], e1=nir->Ioff[j+1];
+	if(e0==e1)  return 0;
+	for(u64 e=e0+1; e<e1; ++e)
+		if(nir->Iidx[e]!=nir->Iidx[e0]+(e-e0))  return 0;
+	return 1;
+}
+
+// @meta  O[V+E] find all maximal blocks (of at least NIRBLK_MDIM_MIN neurons), in ascending order of j
+// @ret  a vec of blocks (caller must vend() it)
+fdef nirblk_t* nirblk_ini(nir_t* nir){
+	nirblk_t* blks = vini(nirblk_t);
+	i64 N=nir->N, j=0;
+	while(j<N){
+		if(!nirblk_contiguous(nir,j)){  ++j;  continue;  }
+		u32 i=nir->Iidx[nir->Ioff[j]], k=nir_idim(nir,j);
+		i64 m=1;
+		while(j+m<N && nir->F[j+m]==nir->F[j] && nir_idim(nir,j+m)==k && nir->Iidx[nir->Ioff[j+m]]==i && nirblk_contiguous(nir,j+m))  ++m;
+		if(NIRBLK_MDIM_MIN<=m)  vpush(blks, ((nirblk_t){j:j,m:m, i:i,k:k, e:nir->Ioff[j]}));
+		j+=m;
+	}
+	return blks;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirconv: conv stencils, ie. planes of neurons whose in -sets are the same window, translated over a 2D grid
+/*
+a conv plane is a run of Ho*Wo neurons nj .. nj+Ho*Wo-1 (a Ho x Wo grid, row-major) w/ the same activation fn and level, reading C in -planes of Hi x Wi neurons at ni .. ni+C*Hi*Wi-1 (also row-major):
+the in -set of the neuron at (y,x) is exactly { ni + c*Hi*Wi + iy*Wi + ix  :  c<C, dy<K, dx<K, iy=y*s+dy-p, ix=x*s+dx-p, 0<=iy<Hi, 0<=ix<Wi }, ie. a K x K window w/ stride s and (zero) padding p
+the grid, the kernel size, the stride and the padding are all inferred from the in -sets: a conv plane is a geometry that reproduces every in -set of the plane exactly, in any NAL order
+the NAL can't say whether a plane shares its weights, so a conv plane is only lowered (to a direct convolution w/ C*K*K weights) if the user declares weight sharing (-s)
+*/
+#define NIRCONV_PDIM_MIN  2  // the smallest out-plane worth a loop nest
+
+tdef{
+	u32 j,i;        // the 1st out-neuron and the 1st in -neuron
+	u32 Ho,Wo;      // out-plane
+	u32 C,Hi,Wi;    // in -planes
+	u32 K,s,p;      // window, stride, padding
+}nirconv_t;
+
+// @meta  does @cv reproduce every in -set of its plane? @seen has room for C*K*K items
+fdef int nirconv_chk(nir_t* nir, nirlvl_t* lvl, nirconv_t* cv, u8* seen){
+	i64 HW=(i64)cv->Hi*cv->Wi, D=(i64)cv->C*cv->K*cv->K;
+	mfor(y,0,cv->Ho)  mfor(x,0,cv->Wo){
+		i64 j = cv->j + y*cv->Wo + x;
+		if(nir->F[j]!=nir->F[cv->j] || lvl->lvl[j]!=lvl->lvl[cv->j])  return 0;
+		i64 y0=y*cv->s-cv->p, x0=x*cv->s-cv->p;  // the window's top-left corner, in the in -plane
+		i64 kh = mmin(y0+cv->K,cv->Hi) - mmax(y0,0);
+		i64 kw = mmin(x0+cv->K,cv->Wi) - mmax(x0,0);
+		if(nir_idim(nir,j) != cv->C*kh*kw)  return 0;
+		memset(seen,0x00,D);
+		for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){
+			i64 r = (i64)nir->Iidx[e] - cv->i;  if(r<0 || cv->C*HW<=r)  return 0;
+			i64 c=r/HW, dy=(r%HW)/cv->Wi - y0, dx=(r%HW)%cv->Wi - x0;
+			if(dy<0 || cv->K<=dy || dx<0 || cv->K<=dx)  return 0;
+			u8* f = &seen[(c*cv->K+dy)*cv->K+dx];  if(*f)  return 0;  *f=1;
+		}
+	}
+	return 1;
+}
+
+fdef int nirconv_cmp(const void* a, const void* b){  return (*(u32*)a > *(u32*)b) - (*(u32*)a < *(u32*)b);  }
+
+// @meta  find a conv plane w/ the largest grid that starts at neuron nj and fits in nj .. nj+m-1, by trying every geometry the in -sets allow:
+//   - C*K*K is the largest in -degree D, since the window of some neuron nf must be unclipped
+//   - the sorted in -indices of nf give Wi (the distance between its 1st 2 window rows) and, if C>1, Hi*Wi (the distance between its 1st 2 in -planes)
+//   - if C==1, the rows past the last row read are never looked at, so Hi only has to cover the in -indices
+//   - Ho x Wo is a factorization of the grid size, and the stride and the padding follow from the rest
+// @ret  Ho*Wo, or 0 if there's no such plane. @seen has room for D items, and @win for D items
+fdef i64 nirconv_find(nir_t* nir, nirlvl_t* lvl, i64 j, i64 m, u8* seen,u32* win, nirconv_t* ocv){
+	i64 D=0, imin=nir->N, imax=-1, best=0;
+	mfor(P,1,m+1){  // the in -degree and the in -span of the 1st P neurons, incrementally
+		i64 jp=j+P-1;
+		if(D<nir_idim(nir,jp)){  // a new nf
+			D = nir_idim(nir,jp);
+			memcpy(win, nir->Iidx+nir->Ioff[jp], Bsize(u32)*D);  qsort(win,D,sizeof(u32),nirconv_cmp);
+		}
+		for(u64 e=nir->Ioff[jp]; e<nir->Ioff[jp+1]; ++e){  imin=mmin(imin,nir->Iidx[e]);  imax=mmax(imax,nir->Iidx[e]);  }
+		if(P<NIRCONV_PDIM_MIN)  continue;
+		i64 span = imax-imin+1;
+		for(i64 K=2; K*K<=D; ++K){
+			if(D%(K*K))  continue;
+			i64 C=D/(K*K), Wi=win[K]-win[0];
+			if(Wi<K)  continue;
+			i64 Hlo,Hhi;  // the candidates for Hi
+			if(1<C){  i64 HW=win[K*K]-win[0];  if(HW%Wi || C*HW<span)  continue;  Hlo=Hhi=HW/Wi;  }
+			else{     Hlo=divceilu(span,Wi);  Hhi=Hlo+K;  }
+			for(i64 Hi=Hlo; Hi<=Hhi; ++Hi)
+				for(i64 b=1; b*b<=P; ++b)  mfor(tb,0,2){  // every divisor pair of P, as Ho x Wo
+					if(P%b || (tb && b*b==P))  continue;
+					i64 Ho = tb ? P/b : b,  Wo=P/Ho;
+					mfor(st,1,K+1)  mfor(pd,0,K){
+						if(Hi+2*pd<K || Wi+2*pd<K || (Hi+2*pd-K)/st+1!=Ho || (Wi+2*pd-K)/st+1!=Wo)  continue;
+						nirconv_t cv = {j:j,i:imin, Ho:Ho,Wo:Wo, C:C,Hi:Hi,Wi:Wi, K:K,s:st,p:pd};
+						if(nirconv_chk(nir,lvl,&cv,seen)){  *ocv=cv;  best=P;  goto next;  }
+					}
+				}
+		}
+		next:;
+	}
+	return best;
+}
+
+// @meta  find conv planes in every run of consecutive neurons that share a level and an activation fn. a run is searched from its start, and then from the end of each plane found, which is 1st tried as the next plane of the same conv layer (same geometry, next in -planes)
+// @ret  a vec of conv planes, in ascending order of j (caller must vend() it)
+fdef nirconv_t* nirconv_ini(nir_t* nir, nirlvl_t* lvl){
+	nirconv_t* cvs  = vini(nirconv_t);
+	i64        N    = nir->N;
+	i64        Dmax = 0;  mfor(j,0,N)  Dmax=mmax(Dmax,nir_idim(nir,j));
+	u8*        seen = malloc(mmax(Dmax,1));
+	u32*       win  = malloc(Bsize(u32)*mmax(Dmax,1));
+	i64 j=0;
+	while(j<N){
+		if(nir_idim(nir,j)==0){  ++j;  continue;  }
+		i64 m=1;  while(j+m<N && nir_idim(nir,j+m)!=0 && nir->F[j+m]==nir->F[j] && lvl->lvl[j+m]==lvl->lvl[j])  ++m;
+		i64 end=j+m;
+		nirconv_t cv;
+		while(j<end){
+			i64 P = nirconv_find(nir,lvl, j,end-j, seen,win,&cv);
+			if(P==0)  break;
+			do{
+				vpush(cvs,cv);  j+=P;  cv.j=j;
+				if(end<j+P)  break;
+				i64 imin=N;  mfor(q,j,j+P)  for(u64 e=nir->Ioff[q]; e<nir->Ioff[q+1]; ++e)  imin=mmin(imin,nir->Iidx[e]);
+				cv.i=imin;
+			}while(nirconv_chk(nir,lvl,&cv,seen));
+		}
+		j=end;
+	}
+	free(win);
+	free(seen);
+	return cvs;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirmem: the activation arena, ie. liveness-based reuse of neuron slots in the fwd-pass
+/*
+a neuron is live from its level (where it's computed) through the last level that reads it. output neurons live through the end, since y is copied out last. a neuron nobody reads dies at its own level
+a slot freed at level l is only reused from level l+1 on, never within level l, since the statements of a level run in order and a later one may still read it
+GEMVs and conv planes address runs of neurons as n+i, so every run they read or write must stay contiguous (and in order) in the arena: overlapping runs are merged into segments, and a segment is placed as a whole, live from its 1st def through its last use
+segments are placed by first fit in a free list of holes, sorted by offset and coalesced on free. for 1-neuron segments this is left-edge interval coloring, which is optimal: as many slots as there are neurons live at once. for longer segments (ie. variable-size intervals) optimal placement is NP-hard, and first fit is the usual heuristic
+*/
+tdef{
+	i64  A;    // arena size, in neurons
+	u32* a;    // vec of arena slots, [N]: neuron nj lives at n[a[j]]
+	i64  G;    // number of segments of 2 or more neurons
+}nirmem_t;
+
+tdef{
+	u32 off,dim;
+}nirhole_t;
+
+fdef void nirmem_end(nirmem_t* mem){
+	if(mem==NULL) return;
+	if(mem->a!=NULL) vend(mem->a);
+	*mem=(nirmem_t){0x00};
+}
+
+// @meta  O[n+K] counting sort of the items [0 .. n) by key, into K buckets: the items w/ key k are idx[off[k] .. off[k+1]), in ascending order. @off must have room for K+1 items, @idx for n items
+fdef void nirmem_bucket(i64 n, u32* key, i64 K, u64* off,u32* idx){
+	memset(off,0x00,Bsize(u64)*(K+1));
+	mfor(g,0,n)  ++off[key[g]+1];
+	mfor(k,0,K)  off[k+1] += off[k];
+	u64* pos = malloc(Bsize(u64)*mmax(K,1));  memcpy(pos,off,Bsize(u64)*K);
+	mfor(g,0,n)  idx[pos[key[g]]++] = g;
+	free(pos);
+}
+
+// @meta  O[V+E] plan the arena of the fwd-pass, for the conv planes in @cvs and the blocks in @blks that are emitted (ie. those that @B maps their 1st neuron to)
+// if @keep, every neuron keeps its own slot, n[j], since the bwd-pass reads them all
+fdef void nirmem_ini(nir_t* nir, nirlvl_t* lvl, nirconv_t* cvs, nirblk_t* blks,u32* B, int keep, nirmem_t* omem){
+	i64  N=nir->N, L=lvl->L;
+	if(keep){
+		u32* a = vini1(u32,N+1);  vidim(a)=N;
+		mfor(j,0,N)  a[j]=j;
+		*omem = (nirmem_t){A:N, a:a};
+		return;
+	}
+	u32* ext = malloc(Bsize(u32)*mmax(N,1));  memset(ext,0x00,Bsize(u32)*N);  // ext[j] is the end of the longest run that starts at nj, or 0
+	mfor(c,0,vidim(cvs)){
+		nirconv_t* cv = &cvs[c];
+		ext[cv->j] = mmax(ext[cv->j], cv->j+cv->Ho*cv->Wo);
+		ext[cv->i] = mmax(ext[cv->i], cv->i+cv->C*cv->Hi*cv->Wi);
+	}
+	mfor(b,0,vidim(blks)){
+		nirblk_t* blk = &blks[b];
+		if(B[blk->j]!=b)  continue;
+		ext[blk->j] = mmax(ext[blk->j], blk->j+blk->m);
+		ext[blk->i] = mmax(ext[blk->i], blk->i+blk->k);
+	}
+
+	// ----------------------------------------------------------------  segments: a sweep over the runs, in ascending order of their 1st neuron
+	u32* g  = malloc(Bsize(u32)*mmax(N,1));  // g[j] is the segment of neuron nj
+	u32* gj = vini(u32);                     // the 1st neuron of each segment, and then N
+	i64  end=0;
+	mfor(j,0,N){
+		if(end<=j)  vpush(gj,j);
+		end  = mmax(end, mmax(j+1,ext[j]));
+		g[j] = vidim(gj)-1;
+	}
+	vpush(gj,N);
+	i64  Gn   = vidim(gj)-1;
+	u32* def  = malloc(Bsize(u32)*mmax(Gn,1));  memset(def, 0xff,Bsize(u32)*Gn);  // the level of the 1st def of each segment
+	u32* last = malloc(Bsize(u32)*mmax(Gn,1));  memset(last,0x00,Bsize(u32)*Gn);  // the level of the last use of each segment, plus 1: the level that can reuse it
+	mfor(j,0,N){
+		u32 d=lvl->lvl[j], u=d;
+		if(nir_idim(nir,j)!=0 && nir_odim(nir,j)==0)  u=L;
+		for(u64 o=nir->Ooff[j]; o<nir->Ooff[j+1]; ++o)  u=mmax(u,lvl->lvl[nir->Oidx[o]]);
+		def [g[j]] = mmin(def [g[j]],d);
+		last[g[j]] = mmax(last[g[j]],u+1);
+	}
+	free(g);
+	free(ext);
+
+	// ----------------------------------------------------------------  a sweep over the levels: at level l, free the segments whose last use was level l-1, and then place the segments defined at level l
+	u64* doff = malloc(Bsize(u64)*(L+2));  u32* didx = malloc(Bsize(u32)*mmax(Gn,1));  nirmem_bucket(Gn,def, L+1,doff,didx);
+	u64* uoff = malloc(Bsize(u64)*(L+3));  u32* uidx = malloc(Bsize(u32)*mmax(Gn,1));  nirmem_bucket(Gn,last,L+2,uoff,uidx);
+	u32*       go    = malloc(Bsize(u32)*mmax(Gn,1));  // the offset of each segment
+	nirhole_t* holes = vini(nirhole_t);  // the free runs below the top of the arena, in ascending order of offset, w/ no 2 adjacent
+	i64        A=0, G=0;
+	mfor(l,0,L){
+		for(u64 p=uoff[l]; p<uoff[l+1]; ++p){
+			u32 s=uidx[p], dim=gj[s+1]-gj[s], off=go[s];
+			i64 lo=0, hi=vidim(holes);  // binary search for the 1st hole after @off
+			while(lo<hi){  i64 mid=(lo+hi)/2;  if(holes[mid].off<off) lo=mid+1; else hi=mid;  }
+			i64 h=lo;
+			int prev = 0<h            && holes[h-1].off+holes[h-1].dim==off;
+			int next = h<vidim(holes) && off+dim==holes[h].off;
+			if(prev && next){  holes[h-1].dim += dim+holes[h].dim;  memmove(holes+h,holes+h+1,sizeof(nirhole_t)*(vidim(holes)-h-1));  --vidim(holes);  }
+			else if(prev)      holes[h-1].dim += dim;
+			else if(next){     holes[h].off=off;  holes[h].dim+=dim;  }
+			else{              vpush(holes,((nirhole_t){0}));  memmove(holes+h+1,holes+h,sizeof(nirhole_t)*(vidim(holes)-h-1));  holes[h]=(nirhole_t){off:off,dim:dim};  }
+		}
+		for(u64 p=doff[l]; p<doff[l+1]; ++p){
+			u32 s=didx[p], dim=gj[s+1]-gj[s];
+			G += 1<dim;
+			i64 h=0;  while(h<vidim(holes) && holes[h].dim<dim)  ++h;  // a 1-neuron segment always fits the 1st hole
+			if(h<vidim(holes)){  // first fit
+				go[s]=holes[h].off;  holes[h].off+=dim;  holes[h].dim-=dim;
+				if(holes[h].dim==0){  memmove(holes+h,holes+h+1,sizeof(nirhole_t)*(vidim(holes)-h-1));  --vidim(holes);  }
+			}else if(vidim(holes) && holes[vidim(holes)-1].off+holes[vidim(holes)-1].dim==A){  // the top hole is too small, but the arena can grow past it
+				go[s]=holes[vidim(holes)-1].off;  A=go[s]+dim;  --vidim(holes);
+			}else{
+				go[s]=A;  A+=dim;
+			}
+		}
+	}
+
+	// ----------------------------------------------------------------
+	u32* a = vini1(u32,N+1);  vidim(a)=N;
+	mfor(s,0,Gn)
+		for(u32 j=gj[s]; j<gj[s+1]; ++j)  a[j] = go[s]+(j-gj[s]);
+	vend(holes);
+	free(go);
+	free(uidx); free(uoff);
+	free(didx); free(doff);
+	free(last);
+	free(def);
+	vend(gj);
+	*omem = (nirmem_t){A:A, a:a, G:G};
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirsell: SELL-C-sigma slices, ie. SIMD across neurons
+/*
+a sparse net w/ small, irregular fan-ins (eg. nn00) has no runs for a GEMV, and a dot product of 2-4 terms per neuron leaves the SIMD lanes idle. so the lanes go across neurons instead: a slice is C neurons of the same level and activation fn, and lane c computes the c-th neuron of the slice
+a slice is stored column-major: column t holds the t-th in -neuron (as an arena slot) and the t-th weight of each of its C neurons, so a column is 1 gather of C activations and 1 contiguous load of C weights. a slice has as many columns as its widest neuron, and the shorter neurons are padded w/ a zero weight that reads a zero slot
+to keep the padding small, the neurons of each (level, activation fn) group are sorted by in -degree, descending, before they're cut into slices. this is SELL-C-sigma w/ sigma the whole group: the order within a level is free, since its neurons don't read each other
+a group of fewer than C/2 neurons isn't worth a slice, so it keeps the per-neuron straight-line code, as do GEMV blocks and conv planes
+*/
+tdef{
+	u32 l;       // level
+	u8  f;       // activation fn code
+	u32 m;       // live lanes of the last slice
+	u64 s0,s1;   // slices s0 .. s1-1
+}nirsellgrp_t;
+
+tdef{
+	i64           C;     // lanes per slice
+	nirsellgrp_t* grps;  // vec of groups, in level order
+	u64*          sp;    // vec of slice offsets, [S+1]: slice s is the slots sp[s] .. sp[s+1]-1, ie. (sp[s+1]-sp[s])/C columns
+	u32*          si;    // vec of the in -neuron of each slot, or 0xffffffff (padding)
+	u64*          wp;    // vec of the weight of each slot, or 0xffffffffffffffff (padding)
+	u32*          so;    // vec of the out-neuron of each lane, [C*S], or 0xffffffff (padding)
+	u8*           in;    // in[j] is 1 if neuron nj is in a slice, [N]
+}nirsell_t;
+
+tdef{
+	u64 key;  // activation fn code, and then the complement of the in -degree
+	u32 j;
+}nirsellkey_t;
+
+fdef int nirsellkey_cmp(const void* a, const void* b){
+	const nirsellkey_t* x=a;  const nirsellkey_t* y=b;
+	if(x->key!=y->key)  return x->key<y->key ? -1 : 1;
+	return x->j<y->j ? -1 : x->j>y->j;
+}
+
+fdef void nirsell_end(nirsell_t* sell){
+	if(sell==NULL) return;
+	if(sell->grps!=NULL) vend(sell->grps);
+	if(sell->sp  !=NULL) vend(sell->sp);
+	if(sell->si  !=NULL) vend(sell->si);
+	if(sell->wp  !=NULL) vend(sell->wp);
+	if(sell->so  !=NULL) vend(sell->so);
+	free(sell->in);
+	*sell=(nirsell_t){0x00};
+}
+
+// @meta  O[V*log(V)+E] cut the neurons that aren't in a conv plane (@S) or a block (@B) into slices of @C lanes. the weight of edge e of neuron nj is w[woff[j]+e-Ioff[j]]
+fdef void nirsell_ini(nir_t* nir, nirlvl_t* lvl, u32* S,u32* B, u64* woff, i64 C, nirsell_t* osell){
+	i64 N=nir->N;
+	nirsell_t sell = {C:C, grps:vini(nirsellgrp_t), sp:vini(u64), si:vini(u32), wp:vini(u64), so:vini(u32), in:malloc(mmax(N,1))};
+	memset(sell.in,0x00,N);
+	vpush(sell.sp, 0);
+	nirsellkey_t* keys = malloc(Bsize(nirsellkey_t)*mmax(N,1));
+	mfor(l,1,lvl->L){
+		i64 n=0;
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){
+			u32 j = lvl->idx[p];
+			if(S[j]==0xffffffff && B[j]==0xffffffff)  keys[n++] = (nirsellkey_t){key:((u64)nir->F[j]<<32) | (u32)~nir_idim(nir,j), j:j};
+		}
+		qsort(keys,n,Bsize(nirsellkey_t), nirsellkey_cmp);
+		for(i64 g0=0,g1=0; g0<n; g0=g1){
+			while(g1<n && keys[g1].key>>32==keys[g0].key>>32)  ++g1;
+			if(g1-g0 < mmax(C/2,1))  continue;
+			nirsellgrp_t grp = {l:l, f:keys[g0].key>>32, s0:vidim(sell.sp)-1};
+			for(i64 q=g0; q<g1; q+=C){
+				i64 m = mmin(C,g1-q);
+				i64 K = nir_idim(nir,keys[q].j);  // the widest neuron comes 1st
+				mfor(t,0,K)  mfor(c,0,C){
+					u32 j = c<m ? keys[q+c].j : 0;
+					if(c<m && t<nir_idim(nir,j)){  vpush(sell.si, nir->Iidx[nir->Ioff[j]+t]);  vpush(sell.wp, woff[j]+t);  }
+					else{                          vpush(sell.si, 0xffffffff);                   vpush(sell.wp, 0xffffffffffffffffull);  }
+				}
+				mfor(c,0,C)  vpush(sell.so, c<m ? keys[q+c].j : 0xffffffff);
+				vpush(sell.sp, vidim(sell.si));
+				grp.m = m;
+			}
+			grp.s1 = vidim(sell.sp)-1;
+			mfor(q,g0,g1)  sell.in[keys[q].j]=1;
+			vpush(sell.grps, grp);
+		}
+	}
+	free(keys);
+	*osell = sell;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nircsr: CSR loops for the big levels, w/ the graph in a .csr blob instead of the C code
+/*
+a straight-line statement per neuron makes the generated code O[E]: at 1e8 edges that's gigabytes of C, which no C compiler can build, and whose fwd() is gigabytes of instructions. so past a budget of edges, a level is emitted as 1 call per activation fn to a loop over CSR arrays (ncc_csr()), and the arrays go to a binary blob, a .csr next to the .c, which the generated code reads at run time (ncc_init()). then the C code is O[L] lines, and the i-cache footprint of a level is a loop, whatever its size. the loops are in 1 function, w/ the activation fn as a switch outside the loop, since 1 inlined loop per level makes the C compiler as slow as the straight-line code does (its alias analysis is superlinear in the function size)
+every neuron runs exactly once per fwd(), so no subgraph is hotter than another: the budget goes to the smallest levels (by edges) 1st, since they cost the least code, and they're where the index loads of a loop hurt the most (eg. the output layer). GEMV blocks, conv planes and SELL slices are loops already, so they're not counted
+the .csr is a 128-byte header (csr_t), then the u32 arrays o[P], e[P+1], w[P], i[EP], x[NX], y[NY], each 64-byte aligned. the P neurons are in emission order: neuron p writes arena slot o[p], reads the slots i[e[p] .. e[p+1]), and its weights are w[w[p] ..) (the weights of a neuron are contiguous in edge order). x[k] and y[k] are the slots of the k-th input and output neuron
+*/
+#define CSR_MAGIC        0x007273632e63636eull  // "ncc.csr\0"
+#define CSR_VERSION      1
+#define CSR_ALIGN        64
+#define NCC_UNROLL_EMAX  0x1000   // the default budget, in edges of straight-line code. gcc -O2 takes seconds for 4K edges in 1 function, and it grows superlinearly
+
+tdef{
+	u64 magic;                           // CSR_MAGIC
+	u64 version;                         // CSR_VERSION
+	u64 bdim;                            // file size
+	u64 P,EP,NX,NY;
+	u64 opos,epos,wpos,ipos,xpos,ypos;   // byte offsets of the arrays
+	u64 chk;                             // xxh64 of the bytes after the header. the .c #defines it too, so a .csr can't be paired w/ the wrong .c
+	u64 pad[2];
+}csr_t;
+
+tdef{
+	u32 l;       // level
+	u8  f;       // activation fn code
+	u64 p0,p1;   // neurons p0 .. p1-1
+}nircsrgrp_t;
+
+tdef{
+	u8*          lp;    // lp[l] is 1 if level l is emitted as loops, [L]
+	nircsrgrp_t* grps;  // vec of groups, in level order
+	u32*         o;     // vec of the out-slot of each neuron, [P]
+	u32*         e;     // vec of the 1st edge of each neuron, [P+1]
+	u32*         w;     // vec of the 1st weight of each neuron, [P]
+	u32*         i;     // vec of the in -slot of each edge, [EP]
+	i64          spent; // edges of straight-line code
+}nircsr_t;
+
+fdef int nircsr_cmp(const void* a, const void* b){  return *(u64*)a<*(u64*)b ? -1 : *(u64*)a>*(u64*)b;  }
+
+fdef void nircsr_end(nircsr_t* csr){
+	if(csr==NULL) return;
+	free(csr->lp);
+	if(csr->grps!=NULL) vend(csr->grps);
+	if(csr->o   !=NULL) vend(csr->o);
+	if(csr->e   !=NULL) vend(csr->e);
+	if(csr->w   !=NULL) vend(csr->w);
+	if(csr->i   !=NULL) vend(csr->i);
+	*csr=(nircsr_t){0x00};
+}
+
+// @meta  O[V+E+L*log(L)] pick the levels that are emitted as loops, w/ at most @budget edges of straight-line code, and lay out the CSR arrays of their neurons. a neuron is in a loop iff @loose says it'd be its own statement (ie. it's not in a block, a conv plane or a SELL slice) and its level is
+fdef void nircsr_ini(nir_t* nir, nirlvl_t* lvl, u8* loose, u64* woff, u32* a, i64 budget, nircsr_t* ocsr){
+	i64  L   = lvl->L;
+	nircsr_t csr = {lp:malloc(mmax(L,1)), grps:vini(nircsrgrp_t), o:vini(u32), e:vini(u32), w:vini(u32), i:vini(u32)};
+	memset(csr.lp,0x00,L);
+	vpush(csr.e, 0);
+	u64* le = malloc(Bsize(u64)*mmax(L,1));  // le[l] is the edges of the loose neurons of level l
+	u64* ls = malloc(Bsize(u64)*mmax(L,1));  // the levels, sorted by le[] (in the high bits)
+	mfor(l,0,L){
+		le[l]=0;
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p)
+			if(loose[lvl->idx[p]])  le[l] += nir_idim(nir,lvl->idx[p]);
+		nnchk(0xffffffffull<=le[l] || 0xffffffffull<=(u64)L, "level \x1b[34m%ld \x1b[0mhas \x1b[34m%'lu \x1b[0medges, but the CSR loops index them w/ 32 bits", l,le[l]);
+		ls[l] = le[l]<<32 | l;
+	}
+	qsort(ls,L,Bsize(u64), nircsr_cmp);
+	mfor(q,0,L){  // smallest 1st: once a level doesn't fit, none after it does
+		u64 l = ls[q]&0xffffffff;
+		if(csr.spent+(i64)le[l] <= budget)  csr.spent += le[l];
+		else                                csr.lp[l] = 1;
+	}
+	mfor(l,1,L){
+		if(!csr.lp[l])  continue;
+		mfor(f,0,7){  // 1 group per activation fn, so the fn is a constant of its loop
+			nircsrgrp_t grp = {l:l, f:f, p0:vidim(csr.o)};
+			for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){
+				u32 j = lvl->idx[p];
+				if(!loose[j] || nir->F[j]!=f)  continue;
+				vpush(csr.o, a[j]);
+				vpush(csr.w, woff[j]);
+				for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e)  vpush(csr.i, a[nir->Iidx[e]]);
+				nnchk(0xffffffffull<=vidim(csr.i), "the CSR loops index their edges w/ 32 bits, but there are more than \x1b[34m%'lu\x1b[0m", (u64)0xffffffff);
+				vpush(csr.e, vidim(csr.i));
+			}
+			grp.p1 = vidim(csr.o);
+			if(grp.p0<grp.p1)  vpush(csr.grps, grp);
+		}
+	}
+	free(ls);
+	free(le);
+	*ocsr = csr;
+}
+
+// @meta  write the .csr of @csr to @path. @x and @y are the slots of the inputs and the outputs. @ret its header
+fdef csr_t nircsr_save(char* path, nircsr_t* csr, u32* x,i64 NX, u32* y,i64 NY){
+	i64   P=vidim(csr->o), EP=vidim(csr->i);
+	csr_t h    = {magic:CSR_MAGIC, version:CSR_VERSION, P:P,EP:EP,NX:NX,NY:NY};
+	u64   bdim = sizeof(csr_t);
+	h.opos = bdim;  bdim = divceilu64(bdim + Bsize(u32)*P,     CSR_ALIGN)*CSR_ALIGN;
+	h.epos = bdim;  bdim = divceilu64(bdim + Bsize(u32)*(P+1), CSR_ALIGN)*CSR_ALIGN;
+	h.wpos = bdim;  bdim = divceilu64(bdim + Bsize(u32)*P,     CSR_ALIGN)*CSR_ALIGN;
+	h.ipos = bdim;  bdim = divceilu64(bdim + Bsize(u32)*EP,    CSR_ALIGN)*CSR_ALIGN;
+	h.xpos = bdim;  bdim = divceilu64(bdim + Bsize(u32)*NX,    CSR_ALIGN)*CSR_ALIGN;
+	h.ypos = bdim;  bdim = divceilu64(bdim + Bsize(u32)*NY,    CSR_ALIGN)*CSR_ALIGN;
+	h.bdim = bdim;
+	u8* data = aligned_alloc(CSR_ALIGN,bdim);  memset(data,0x00,bdim);
+	memcpy(data+h.opos, csr->o, Bsize(u32)*P);
+	memcpy(data+h.epos, csr->e, Bsize(u32)*(P+1));
+	memcpy(data+h.wpos, csr->w, Bsize(u32)*P);
+	memcpy(data+h.ipos, csr->i, Bsize(u32)*EP);
+	memcpy(data+h.xpos, x,      Bsize(u32)*NX);
+	memcpy(data+h.ypos, y,      Bsize(u32)*NY);
+	h.chk = xxh64(data+sizeof(csr_t), bdim-sizeof(csr_t), CSR_MAGIC);
+	memcpy(data,&h,sizeof(csr_t));
+	file_save(path, data,bdim);
+	free(data);
+	nnlogf("\x1b[92mnircsr_save  \x1b[0mP \x1b[34m%'ld  \x1b[0mEP \x1b[34m%'ld  \x1b[0mbdim \x1b[34m%'lu  \x1b[92m%s\x1b[0m\n", P,EP,bdim, path);
+	return h;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirtu: the translation units of the generated code
+/*
+a C compiler is superlinear in the size of a function, and single-threaded per TU, so 1 giant fwd() is the slowest thing to build. -T n cuts the schedule (the levels, and the neurons of each level, in the order @nirgen emits them) into n parts of about the same size, and part t is `void ncc_fwd<t>(x,w)`, in TU t. fwd() is then a driver that calls the parts in order (bwd() likewise, w/ the parts of the bwd-pass, ncc_bwd<t>(w,dw))
+the size of a neuron is the code it emits: 1 + its in-edges for straight-line code, 1 for a GEMV block, a conv plane or a SELL/CSR loop, 0 for the neurons those cover. so the parts are cut by the edges of their straight-line code, which is what the C compiler spends its time on
+the neurons of a level don't read each other and don't share slots, so a level can be cut anywhere, and a part flushes its deferred vector activations (see @nirgen_vec) before the next one starts
+TU 0 is the main file (@path): the drivers, part 0, and the definitions of the state the parts share (the arena, the SELL tables, the CSR arrays). TU t is <stem>.t.c, and all of them #include <stem>.h, w/ the defines, the kernels and the extern declarations. the shared state is hidden (ELF visibility), so a .so only exports what the single-TU file does
+*/
+tdef{
+	i64    T;      // parts (and TUs)
+	FILE** fps;    // fps[t] is TU t. fps[0] is the main file
+	u32*   cost;   // cost[j] is the size of the code of neuron nj, in the pass at hand
+	i64    total;  // SUM[j, cost[j]]
+	i64    done;   // the cost emitted so far
+	i64    t;      // the current part
+}nirtu_t;
+
+// @meta  the path of TU @t of the C file @path, w/ extension @ext: <stem>.t<ext>, or <stem><ext> for t<0 (eg. the header, or the object of TU 0). caller must free() it
+fdef char* nirtu_path(char* path, i64 t, char* ext){
+	i64   bdim  = strlen(path) - (path_endswith(path,".c") ? 2 : 0);
+	char* tpath = malloc(bdim+strlen(ext)+32);
+	memcpy(tpath,path,bdim);
+	if(t<0)  sprintf(tpath+bdim, "%s", ext);
+	else     sprintf(tpath+bdim, ".%ld%s", t,ext);
+	return tpath;
+}
+
+// @meta  start a pass over the schedule, w/ the neuron sizes @cost
+fdef void nirtu_begin(nirtu_t* tu, u32* cost, i64 N){
+	tu->cost=cost;  tu->total=0;  tu->done=0;  tu->t=0;
+	mfor(j,0,N)  tu->total += cost[j];
+}
+
+// @meta  1 if neuron nj goes to the next part: part t is full once the parts so far have t+1 T-ths of the total
+fdefi int nirtu_cut(nirtu_t* tu, u32 j){
+	if(tu->T<=1 || tu->cost[j]==0)  return 0;
+	int cut = tu->t+1<tu->T && (tu->t+1)*tu->total <= tu->done*tu->T;
+	tu->done += tu->cost[j];
+	return cut;
+}
+
+// @meta  end the current part of pass @fn, and start the next one, `void ncc_<fn><t>(<sig>)`. @ret its file
+fdef FILE* nirtu_next(nirtu_t* tu, char* fn, char* sig){
+	fprintf(tu->fps[tu->t], "}\n\n");
+	++tu->t;
+	fprintf(tu->fps[tu->t], "void ncc_%s%ld(%s){\n", fn,tu->t,sig);
+	return tu->fps[tu->t];
+}
+
+// @meta  emit the shared state @decl (a declaration w/o storage class, up to its newline): static in a single TU. split, it's defined in TU 0 (@fp) and declared extern in the header (@fh)
+fdef void nirtu_decl(FILE* fh, FILE* fp, int split, char* decl){
+	if(!split){  fprintf(fp, "static %s", decl);  return;  }
+	fprintf(fh, "extern %s", decl);
+	fprintf(fp, "%s", decl);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1
+// @meta  1 if activation fn @f goes through the vector kernels of mathisart4.h (f32_act(), see @fp_src_act), ie. if it isn't the identity or relu, which are cheaper inline
+fdefi int nir_fvec(u32 f){  return f!=0x00 && f!=0x03;  }
+
+// @meta  emit w[@k] of neuron nj, ie. its weight of in-edge @k: w[woff[j]+k], or, if @woff is NULL, w[ncc_wo[j]+k], where the weights of nj aren't at an offset the code can know (see @blk1 nirdif)
+fdefi void nirgen_w(FILE* fp, u64* woff, u32 j, u64 k){
+	if(woff!=NULL)  fprintf(fp, "w[%lu]", woff[j]+k);
+	else            fprintf(fp, "w[ncc_wo[%u]+%lu]", j,k);
+}
+
+// @meta  emit the groups of loose neurons @js of a level, whose activation fn is @f, a chunk of at most 256 at a time: the dot products go to a tmp array, and 1 f32_act() call takes them all (singletons call ncc_fF, on 1 lane). @woff may be NULL (see @nirgen_w)
+fdef void nirgen_vec(FILE* fp, nir_t* nir, u32* a, u64* woff, int grad, u32 f, u32* js){
+	for(i64 q0=0; q0<vidim(js); q0+=0x100){
+		i64 k = mmin(vidim(js)-q0, 0x100);
+		if(k==1){
+			u32 j = js[q0];
+			fprintf(fp, "\tn[%u] = ncc_f%u(", a[j],f);
+			if(grad)  fprintf(fp, "z[%u] =", j);
+			for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){  fprintf(fp, " +n[%u]*", a[nir->Iidx[e]]);  nirgen_w(fp, woff, j,e-nir->Ioff[j]);  }
+			fprintf(fp, ");\n");
+			continue;
+		}
+		fprintf(fp, "\t{  float t[%ld];\n", k);
+		mfor(q,0,k){
+			u32 j = js[q0+q];
+			fprintf(fp, "\tt[%ld] =", q);
+			if(grad)  fprintf(fp, " z[%u] =", j);
+			for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){  fprintf(fp, " +n[%u]*", a[nir->Iidx[e]]);  nirgen_w(fp, woff, j,e-nir->Ioff[j]);  }
+			fprintf(fp, ";\n");
+		}
+		fprintf(fp, "\tf32_act(%u,NCC_SWISH_BETA, %ld,t,t);\n\t", f,k);
+		mfor(q,0,k)  fprintf(fp, "n[%u]=t[%ld];  ", a[js[q0+q]],q);
+		fprintf(fp, "}\n");
+	}
+}
+
+// @meta  the head of bwd(): zero g, and seed it w/ dy
+fdef void nirgen_bwd_head(FILE* fp, nir_t* nir, i64 P){
+	i64 k=0;
+	fprintf(fp, "\nvoid bwd(const float* dy, const float* w, float* dw, float* dx){\n");
+	fprintf(fp, "\tfor(int j=0; j<NCC_N; ++j)  g[j] = 0.0f;\n");
+	if(0<P)  fprintf(fp, "\tfor(int k=0; k<NCC_NY; ++k)  g[ncc_y[k]] = dy[k];\n");
+	else mfor(j,0,nir->N)
+		if(nir_idim(nir,j)!=0 && nir_odim(nir,j)==0)  fprintf(fp, "\tg[%ld] = dy[%ld];\n", j,k++);
+}
+
+// @meta  emit the bwd-pass: `void bwd(const float* dy, const float* w, float* dw, float* dx)`, ie. reverse-mode accumulation over the levels, from the last one down, in O[V+E]
+// g[j] starts as DL/Dn[j]: dy for output neurons, and 0 for the rest. by the time level l comes up, every neuron above it has added its share to g[j], so g[j] is complete: it becomes the delta g[j]*fj'(z[j]), and then it flows down each in -edge wij, as g[i] += wij*g[j] and dw[ij] += g[j]*n[i]
+// blocks and conv planes go through their own bwd kernels, w/ the same weight offsets as the fwd-pass
+fdef void nirgen_bwd(nirtu_t* tu, nir_t* nir, nirlvl_t* lvl, nirconv_t* cvs,u32* S, nirblk_t* blks,u32* B, u64* woff, u8* loose,nircsr_t* csr){
+	i64   N=nir->N, k=0, P=vidim(csr->o), c=vidim(csr->grps)-1;
+	int   split = 1<tu->T;
+	FILE* fp    = tu->fps[0];
+	FILE* fq    = fp;  // the file of the current part
+	u32*  cost  = malloc(Bsize(u32)*mmax(N,1));  // the size of the bwd code of each neuron (see @blk1 nirtu)
+	mfor(j,0,N){
+		if(nir_idim(nir,j)==0 || (csr->lp[lvl->lvl[j]] && loose[j]))  cost[j] = 0;
+		else if(S[j]!=0xffffffff)  cost[j] = cvs[S[j]].j==j;
+		else if(B[j]!=0xffffffff)  cost[j] = blks[B[j]].j==j;
+		else                       cost[j] = 1+nir_idim(nir,j);
+	}
+	nirtu_begin(tu, cost,N);
+	u32* js[7];  mfor(f,0,7)  js[f]=vini(u32);  // the per-neuron code of a level, per activation fn
+	if(split)  fprintf(fp, "\nvoid ncc_bwd0(const float* w, float* dw){\n");
+	else       nirgen_bwd_head(fp, nir, P);
+	for(i64 l=lvl->L-1; 0<l; --l){
+		fprintf(fq, "\t// level %ld: %lu neurons\n", l,lvl->off[l+1]-lvl->off[l]);
+		for(; 0<=c && csr->grps[c].l==l; --c){  // the neurons of a level don't read each other, so its CSR loops can go 1st
+			nircsrgrp_t* grp = &csr->grps[c];
+			fprintf(fq, "\tncc_csr_bwd(%lu,%lu, %u, w,dw);\n", grp->p0,grp->p1, grp->f);
+		}
+		mfor(f,0,7)  vkeepn(js[f],0);
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){  // the deltas of the level are final, so the derivatives of its per-neuron code go 1st, 1 f32_dact() per chunk
+			u32 j = lvl->idx[p];
+			if(S[j]==0xffffffff && B[j]==0xffffffff && !(csr->lp[l] && loose[j]) && nir_fvec(nir->F[j]))  vpush(js[nir->F[j]], j);
+		}
+		mfor(f,0,7){
+			if(vidim(js[f])<2)  continue;
+			for(i64 q0=0; q0<vidim(js[f]); q0+=0x100){
+				i64 m = mmin(vidim(js[f])-q0, 0x100);
+				fprintf(fq, "\t{  float t[]={");  mfor(q,0,m)  fprintf(fq, "%sg[%u]", q==0?"":",", js[f][q0+q]);
+				fprintf(fq, "}, u[]={");           mfor(q,0,m)  fprintf(fq, "%sz[%u]", q==0?"":",", js[f][q0+q]);
+				fprintf(fq, "};  f32_dact(%ld,NCC_SWISH_BETA, %ld,t,u);  ", f,m);
+				mfor(q,0,m)  fprintf(fq, "g[%u]=t[%ld];  ", js[f][q0+q],q);
+				fprintf(fq, "}\n");
+			}
+		}
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){
+			u32 j = lvl->idx[p];
+			if(nirtu_cut(tu,j))  fq = nirtu_next(tu, "bwd","const float* w, float* dw");
+			if(csr->lp[l] && loose[j])  continue;
+			if(S[j]!=0xffffffff){
+				nirconv_t* cv = &cvs[S[j]];
+				if(cv->j!=j)  continue;
+				if(nir_fvec(nir->F[j]))  fprintf(fq, "\tf32_dact(%u,NCC_SWISH_BETA, %u,g+%u,z+%u);\n", nir->F[j], cv->Ho*cv->Wo, cv->j,cv->j);
+				else                     fprintf(fq, "\tfor(int r=%u; r<%u; ++r)  g[r] *= ncc_d%u(z[r],n[r]);\n", cv->j,cv->j+cv->Ho*cv->Wo, nir->F[j]);
+				fprintf(fq, "\tncc_conv_bwd(%u,%u, %u,%u,%u, %u,%u,%u, n+%u, w+%lu, g+%u, dw+%lu, g+%u);\n", cv->Ho,cv->Wo, cv->C,cv->Hi,cv->Wi, cv->K,cv->s,cv->p, cv->i, woff[j], cv->j, woff[j], cv->i);
+				continue;
+			}
+			if(B[j]!=0xffffffff){
+				nirblk_t* blk = &blks[B[j]];
+				if(blk->j!=j)  continue;
+				if(nir_fvec(nir->F[j]))  fprintf(fq, "\tf32_dact(%u,NCC_SWISH_BETA, %u,g+%u,z+%u);\n", nir->F[j], blk->m, blk->j,blk->j);
+				else                     fprintf(fq, "\tfor(int r=%u; r<%u; ++r)  g[r] *= ncc_d%u(z[r],n[r]);\n", blk->j,blk->j+blk->m, nir->F[j]);
+				fprintf(fq, "\tncc_gemv_bwd(%u,%u, w+%lu, n+%u, g+%u, dw+%lu, g+%u);\n", blk->m,blk->k, woff[j], blk->i, blk->j, woff[j], blk->i);
+				continue;
+			}
+			if(2<=vidim(js[nir->F[j]]) && nir_fvec(nir->F[j]))  fprintf(fq, "\t{  float d = g[%u];", j);
+			else                                               fprintf(fq, "\t{  float d = g[%u] *= ncc_d%u(z[%u],n[%u]);", j,nir->F[j],j,j);
+			for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){
+				u32 i=nir->Iidx[e];  u64 we=woff[j]+(e-nir->Ioff[j]);
+				fprintf(fq, "  g[%u] += w[%lu]*d;  dw[%lu] += d*n[%u];", i,we, we,i);
+			}
+			fprintf(fq, "  }\n");
+		}
+	}
+	if(split){  // the driver
+		fprintf(fq, "}\n\n");
+		nirgen_bwd_head(fp, nir, P);
+		mfor(t,0,tu->t+1)  fprintf(fp, "\tncc_bwd%ld(w,dw);\n", t);
+	}
+	fprintf(fp, "\tif(dx==NULL)  return;\n");
+	k=0;
+	if(0<P)  fprintf(fp, "\tfor(int k=0; k<NCC_NX; ++k)  dx[k] = g[ncc_x[k]];\n");
+	else mfor(j,0,N)
+		if(nir_idim(nir,j)==0)  fprintf(fp, "\tdx[%ld] = g[%ld];\n", k++,j);
+	fprintf(fp, "}\n");
+	mfor(f,0,7)  vend(js[f]);
+	free(cost);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  batch: the number of samples per fwd() call of the batched fwd-pass
+#define NCC_BATCH_MIN  16      // 1 AVX-512 vector (2 AVX2 vectors) of floats
+#define NCC_BATCH_MAX  256
+#define NCC_L1_BDIM    0x8000  // L1d size, if sysconf doesn't know it
+
+// @meta  pick the batch: the largest power of 2 in [NCC_BATCH_MIN..NCC_BATCH_MAX] such that the activation tile of every level fits in L1
+// the tile of a level is the rows it writes plus the distinct rows it reads, and a row is 1 neuron over the whole batch. if the widest tile doesn't fit even at NCC_BATCH_MIN, the batch is NCC_BATCH_MIN anyway: each weight is still loaded once per NCC_BATCH_MIN samples, instead of once per sample
+fdef i64 nirbatch(nir_t* nir, nirlvl_t* lvl){
+	i64  l1   = sysconf(_SC_LEVEL1_DCACHE_SIZE);  if(l1<=0)  l1=NCC_L1_BDIM;
+	u32* seen = malloc(Bsize(u32)*mmax(nir->N,1));  memset(seen,0xff,Bsize(u32)*nir->N);  // seen[i] is the last level that read neuron ni
+	i64  tile = 1;  // in rows
+	mfor(l,1,lvl->L){
+		i64 t = lvl->off[l+1]-lvl->off[l];
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){
+			u32 j = lvl->idx[p];
+			for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e)
+				if(seen[nir->Iidx[e]]!=l){  seen[nir->Iidx[e]]=l;  ++t;  }
+		}
+		tile = mmax(tile,t);
+	}
+	free(seen);
+	i64 batch = NCC_BATCH_MIN;
+	while(batch<NCC_BATCH_MAX && tile*2*batch*(i64)Bsize(f32)<=l1)  batch*=2;
+	nnlogf("\x1b[92mnirbatch  \x1b[0mtile \x1b[34m%'ld \x1b[0mrows  L1 \x1b[34m%'ld \x1b[0mB  batch \x1b[34m%ld\x1b[0m\n", tile,l1,batch);
+	return batch;
+}
+
+// @meta  the head of fwd(): its signature, and the inputs, if they go through the .csr
+fdef void nirgen_fwd_head(FILE* fp, int bat, i64 P){
+	if(bat)  fprintf(fp, "void fwd(const float* restrict x, float* restrict y, const float* restrict w){  // restrict: w doesn't alias n, so each weight is loaded once per row\n");
+	else     fprintf(fp, "void fwd(const float* x, float* y, const float* w){\n");
+	if(0<P && bat)  fprintf(fp, "\tfor(int k=0; k<NCC_NX; ++k)  for(int b=0; b<NCC_BATCH; ++b)  n[ncc_x[k]][b] = x[k*NCC_BATCH+b];\n");
+	else if(0<P)    fprintf(fp, "\tfor(int k=0; k<NCC_NX; ++k)  n[ncc_x[k]] = x[k];\n");
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nccrt: the runtime of the generated code
+/*
+the runtime is the part of the generated C that's the same for every model: the libc headers, and the activation kernels (see @fp_src_act: the vector types, f32_act(), f32_dact(), and their scalar fallback). by default @nirgen inlines it, so a C file is self-contained. -R puts it in 2 headers next to the C file instead, and the C #include's the one it needs:
+	- nccrt.h: <math.h>, <stddef.h>, <stdio.h>, <stdlib.h>, and the kernels
+	- nccrt_simd.h: nccrt.h, plus <immintrin.h> for the SELL slices. it's apart because it's the biggest of all, bigger to parse than the code of a small model, so only the TUs that need it pay for it
+a header is preprocessed and parsed by every TU that #include's it, every time. -K precompiles them instead (gcc's .gch), once per cache dir, ncc build and C compiler, in dir/rt<key>, and every model of the cache #include's them from there, so each TU loads the parsed header instead of parsing it again. the runtime is the 1st #include of each TU, which is what gcc requires to use a .gch
+*/
+#define NCC_RT       "nccrt.h"
+#define NCC_RT_SIMD  "nccrt_simd.h"
+
+// @meta  emit the activation kernels, or their scalar fallback for compilers w/o GCC vector extensions
+fdef void nccrt_act(FILE* fp){
+	fprintf(fp, "// the activation fns (see mathisart4.h): f32_act(f,b,m,y,z) sets y[i] = f(z[i]) for i in [0..m), 16 at a time, and f32_dact(f,b,m,g,z) multiplies g[i] by f'(z[i])\n");
+	fprintf(fp, "#if defined(__GNUC__) && !defined(__TINYC__)\n");  fp_srcput(fp, fp_src_act);
+	fprintf(fp, "#else\n");                                        fp_srcput(fp, fp_src_act_f32);
+	fprintf(fp, "#endif\n\n");
+}
+
+// @meta  write the runtime headers to @dir, as <name><sfx>. both are self-contained (nccrt_simd.h doesn't #include nccrt.h), so they can be written under a tmp @sfx, and then rename()'d
+fdef void nccrt_put(char* dir, char* sfx){
+	mfor(simd,0,2){
+		char* path = malloc(strlen(dir)+strlen(sfx)+32);  sprintf(path, "%s/%s%s", dir, simd ? NCC_RT_SIMD : NCC_RT, sfx);
+		FILE* fp   = fopen(path,"w");  nnchk(fp==NULL, "can't open \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+		fprintf(fp, "// generated by ncc. DO NOT EDIT\n// the runtime of the C that ncc generates: the code that's the same for every model%s\n", simd ? ", and the intrinsics of the SELL slices" : "");
+		fprintf(fp, "#if !defined(NCC_RT_H)\n#define NCC_RT_H\n");
+		fprintf(fp, "#include <math.h>\n#include <stddef.h>\n#include <stdio.h>\n#include <stdlib.h>\n");
+		if(simd)  fprintf(fp, "#if defined(__AVX2__)\n#include <immintrin.h>\n#endif\n");
+		fprintf(fp, "\n");
+		nccrt_act(fp);
+		fprintf(fp, "#endif\n");
+		nnchk(fclose(fp)!=0, "can't write \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+		free(path);
+	}
+}
+
+// @meta  the dir of the file @path, eg. for the runtime headers of a C file. caller must free() it
+fdef char* nccrt_dir(char* path){
+	char* s   = strrchr(path,'/');
+	char* dir = strdup(s==NULL ? "." : path);
+	if(s!=NULL)  dir[mmax(s-path,1)] = 0x00;  // "/x" is in "/"
+	return dir;
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1
+// @meta  emit a self-contained C file for the fwd-pass: `void fwd(const float* x, float* y, const float* w)`
+//   - x is indexed by input  neuron (no in -indices) in neuron order
+//   - y is indexed by output neuron (no out-indices) in neuron order
+//   - w is indexed by edge, in edge order: neurons nj in ascending order, and, for each nj, the in-indices Ij in NAL order
+//   - if @share, every conv plane (see @nirconv_ini) has C*K*K weights instead, at the spot of its 1st neuron, and its other neurons have none
+// neurons are evaluated level by level (see @nirlvl_ini), so they can be listed in any order. shared conv planes are evaluated as a direct convolution each, dense blocks (see @nirblk_ini) as a GEMV each, and every other neuron as its own dot product
+// neuron values live in an activation arena (see @nirmem_ini), where a slot is reused once its neuron has no readers left
+// if @grad, also emit the bwd-pass (see @nirgen_bwd): then every neuron keeps its slot, and its pre-activation too
+// if 0<@sellc, the neurons that aren't in a block or a conv plane are cut into SELL slices of @sellc lanes (see @nirsell_ini), where each lane computes a different neuron. their weights are packed, by `void wpack(const float* w)`, into a static array of the generated file
+// the levels past the straight-line budget of @unroll edges become CSR loops (see @nircsr_ini), whose arrays go to a .csr blob next to @path, that the generated code reads w/ `int ncc_init(const char* path)`
+// if 1<@tus, the code is split into @tus TUs (see @blk1 nirtu): @path, <stem>.1.c .. , and <stem>.h
+// if @rt, the code #include's the runtime headers (see @blk1 nccrt) instead of inlining them. they aren't written here
+// if 1<@batch, fwd() runs @batch samples per call, in structure-of-arrays layout: x[k*NCC_BATCH+b] is the k-th input of sample b (y likewise), and every arena slot is a row n[a][0..NCC_BATCH). each weight is loaded once per row and broadcast over the batch, so the inner loops are FMAs over the batch, which the C compiler vectorizes
+fdef void nirgen(char* path, char* srcpath, nir_t* nir, nirlvl_t* lvl, int share, int grad, i64 batch, i64 sellc, i64 unroll, i64 tus, int rt){
+	i64 N=nir->N, E=nir->E, NX=0, NY=0;
+	u8  fs[7]={0x00};  // fs[f] is 1 if some neuron has activation fn f
+	mfor(j,0,N){
+		nnchk(0x06<nir->F[j], "unknown activation fn code \x1b[35m%02x \x1b[0mfor neuron n\x1b[32m%02lx\x1b[0m", nir->F[j],j);
+		if(nir_idim(nir,j)!=0)  fs[nir->F[j]]=1;
+		if(     nir_idim(nir,j)==0) ++NX;
+		else if(nir_odim(nir,j)==0) ++NY;
+	}
+	nirconv_t* cvs = share ? nirconv_ini(nir,lvl) : vini(nirconv_t);
+	u32*       S   = malloc(Bsize(u32)*mmax(N,1));  memset(S,0xff,Bsize(u32)*N);  // S[j] is the conv plane of neuron nj, or 0xffffffff
+	i64        SE  = 0;  // edges covered by conv planes
+	mfor(c,0,vidim(cvs)){
+		mfor(r,0,cvs[c].Ho*cvs[c].Wo)  S[cvs[c].j+r]=c;
+		SE += nir->Ioff[cvs[c].j+cvs[c].Ho*cvs[c].Wo] - nir->Ioff[cvs[c].j];
+	}
+	u64* woff = nir->Ioff;  // the 1st weight of neuron nj
+	if(share){
+		woff = malloc(Bsize(u64)*(N+1));  woff[0]=0;
+		mfor(j,0,N){
+			i64 wdim = nir_idim(nir,j);
+			if(S[j]!=0xffffffff)  wdim = cvs[S[j]].j==j ? cvs[S[j]].C*cvs[S[j]].K*cvs[S[j]].K : 0;
+			woff[j+1] = woff[j]+wdim;
+		}
+	}
+	i64 W = woff[N];
+
+	nirblk_t* blks = nirblk_ini(nir);
+	u32*      B    = malloc(Bsize(u32)*mmax(N,1));  memset(B,0xff,Bsize(u32)*N);  // B[j] is the block of neuron nj, or 0xffffffff
+	i64       BE=0, BN=0;  // edges covered by blocks, number of blocks
+	mfor(b,0,vidim(blks)){
+		int inconv=0;  mfor(r,0,blks[b].m)  inconv |= S[blks[b].j+r]!=0xffffffff;
+		if(inconv)  continue;  // conv planes win
+		mfor(r,0,blks[b].m)  B[blks[b].j+r]=b;
+		BE += (i64)blks[b].m*blks[b].k;  ++BN;
+	}
+	nirmem_t mem;  nirmem_ini(nir,lvl, cvs, blks,B, grad, &mem);
+	u32*     a = mem.a;
+	char*    z = grad ? "z" : "n";  // where the pre-activations go: kept for the bwd-pass, or overwritten in place
+	int      bat = 1<batch;
+	nnchk(grad && bat, "the bwd-pass isn't batched: drop \x1b[35m-B \x1b[0mor \x1b[35m-g\x1b[0m");
+	nnchk(0<sellc && bat, "SELL slices are SIMD across neurons, and a batch is SIMD across samples: drop \x1b[35m-B \x1b[0mor \x1b[35m-C\x1b[0m");
+	nnchk(0<sellc && 0xffffffff<=W, "SELL slices index the weights w/ 32 bits, but there are \x1b[34m%'ld \x1b[0mweights", W);
+	nirsell_t sell = {0x00};
+	if(0<sellc)  nirsell_ini(nir,lvl, S,B, woff, sellc, &sell);
+	i64 SS = 0<sellc ? vidim(sell.sp)-1 : 0;  // SELL slices
+	i64 WS = 0<sellc ? vidim(sell.si)   : 0;  // SELL slots
+	nnchk(0xffffffff<=WS, "SELL slices index their slots w/ 32 bits, but there are \x1b[34m%'ld \x1b[0mslots", WS);
+	i64 SN=0, SNE=0;  // neurons and edges in SELL slices
+	if(0<sellc)  mfor(j,0,N)  if(sell.in[j]){  ++SN;  SNE+=nir_idim(nir,j);  }
+
+	u8* loose = malloc(mmax(N,1));  // loose[j] is 1 if neuron nj is its own statement: not an input, and not in a conv plane, a block or a SELL slice
+	mfor(j,0,N)  loose[j] = nir_idim(nir,j)!=0 && S[j]==0xffffffff && B[j]==0xffffffff && !(0<sellc && sell.in[j]);
+	nircsr_t csr;  nircsr_ini(nir,lvl, loose, woff, a, unroll, &csr);
+	i64   P=vidim(csr.o), EP=vidim(csr.i), CL=0;  mfor(l,0,lvl->L)  CL += csr.lp[l];  // neurons, edges and levels in CSR loops
+	char* csrpath = NULL;
+	csr_t csrh    = {0x00};
+	if(0<P){  // the inputs and the outputs go through the .csr too, since there can be as many of them as there are neurons
+		i64 bdim = strlen(path);
+		csrpath  = malloc(bdim+8);  memcpy(csrpath,path,bdim+1);
+		if(path_endswith(csrpath,".c"))  csrpath[bdim-2]=0x00;
+		strcat(csrpath,".csr");
+		u32* xs = malloc(Bsize(u32)*mmax(NX,1));  u32* ys = malloc(Bsize(u32)*mmax(NY,1));
+		i64  kx=0, ky=0;
+		mfor(j,0,N){
+			if(     nir_idim(nir,j)==0) xs[kx++]=a[j];
+			else if(nir_odim(nir,j)==0) ys[ky++]=a[j];
+		}
+		csrh = nircsr_save(csrpath, &csr, xs,NX, ys,NY);
+		free(ys);  free(xs);
+	}
+
+	int   split = 1<tus;
+	FILE* fp    = fopen(path,"w");  nnchk(fp==NULL, "can't open \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+	setvbuf(fp, NULL,_IOFBF, 0x100000);
+	nirtu_t tu  = {T:mmax(tus,1)};
+	tu.fps      = malloc(sizeof(FILE*)*tu.T);  tu.fps[0]=fp;
+	char*   hpath = split ? nirtu_path(path,-1,".h") : NULL;
+	char*   rtname = 0<sellc ? NCC_RT_SIMD : NCC_RT;
+	FILE*   fh    = fp;  // the declarations that every TU needs: the main file itself, or, split, the header
+	if(split){
+		char* hname = strrchr(hpath,'/')!=NULL ? strrchr(hpath,'/')+1 : hpath;
+		fh = fopen(hpath,"w");  nnchk(fh==NULL, "can't open \x1b[92m%s\x1b[0m: %s", hpath,strerror(errno));
+		setvbuf(fh, NULL,_IOFBF, 0x100000);
+		fprintf(fp, "// generated by ncc from %s. DO NOT EDIT\n// TU 0 of %ld: fwd(), bwd() and the state the TUs share\n", srcpath,tu.T);
+		if(rt)  fprintf(fp, "#include \"%s\"  // 1st, so it can be precompiled\n", rtname);
+		fprintf(fp, "#include \"%s\"\n\n", hname);
+		mfor(t,1,tu.T){
+			char* tpath = nirtu_path(path,t,".c");
+			tu.fps[t] = fopen(tpath,"w");  nnchk(tu.fps[t]==NULL, "can't open \x1b[92m%s\x1b[0m: %s", tpath,strerror(errno));
+			setvbuf(tu.fps[t], NULL,_IOFBF, 0x100000);
+			fprintf(tu.fps[t], "// generated by ncc from %s. DO NOT EDIT\n// TU %ld of %ld\n", srcpath,t,tu.T);
+			if(rt)  fprintf(tu.fps[t], "#include \"%s\"  // 1st, so it can be precompiled\n", rtname);
+			fprintf(tu.fps[t], "#include \"%s\"\n\n", hname);
+			free(tpath);
+		}
+	}
+	fprintf(fh, "// generated by ncc from %s. DO NOT EDIT\n", srcpath);
+	fprintf(fh, "// N %ld neurons, E %ld edges, W %ld weights, NX %ld inputs, NY %ld outputs, L %ld levels, B %ld dense blocks (covering %ld edges), S %ld shared conv planes (covering %ld edges), A %ld arena slots (G %ld contiguous runs)\n", N,E,W,NX,NY,lvl->L,BN,BE,vidim(cvs),SE,mem.A,mem.G);
+	fprintf(fh, "// x[k] is the k-th input  neuron (no in -indices), in neuron order\n");
+	fprintf(fh, "// y[k] is the k-th output neuron (no out-indices), in neuron order\n");
+	fprintf(fh, "// w[e] is the e-th edge, in edge order: neurons nj in ascending order, and, for each nj, the in-indices Ij in NAL order\n");
+	if(share)  fprintf(fh, "//   except that a shared conv plane has C*K*K weights (row-major, over c,dy,dx) at the spot of its 1st neuron, and its other neurons have none\n");
+	if(!grad)  fprintf(fh, "// n[] is the activation arena: a neuron only holds its slot until its last reader has run, and then the slot is reused\n");
+	else{
+		fprintf(fh, "// n[j] is the activation of neuron nj, and z[j] its pre-activation. bwd() reads both, so call it right after fwd(), on the same sample\n");
+		fprintf(fh, "// dy[k] is DL/Dy[k]. bwd() adds DL/Dw[e] to dw[e] (so a batch accumulates: zero dw first), and, if dx is not NULL, sets dx[k] to DL/Dx[k]\n");
+	}
+	if(0<sellc)  fprintf(fh, "// SELL: %ld slices of %ld lanes cover %ld neurons and %ld edges, in %ld slots (%.1f%% padding). fwd() reads their weights from ncc_ws, not w: call wpack(w) before fwd(), and again whenever w changes\n", SS,sellc,SN,SNE,WS, 100.0*(WS-SNE)/mmax(WS,1));
+	if(0<P)  fprintf(fh, "// CSR: %ld levels are loops over %ld neurons and %ld edges, whose arrays are in %s (%ld edges of straight-line code). call ncc_init(NCC_CSR_PATH) once, before fwd()\n", CL,P,EP,csrpath,csr.spent);
+	if(bat)  fprintf(fh, "// batched: fwd() runs NCC_BATCH samples. x[k*NCC_BATCH+b] is the k-th input of sample b, y[k*NCC_BATCH+b] the k-th output, and n[a][b] is slot a of sample b\n");
+	if(rt)  fprintf(fh, "#include \"%s\"\n", rtname);
+	else{
+		fprintf(fh, "#include <math.h>\n");
+		if(grad || 0<P)  fprintf(fh, "#include <stddef.h>\n");
+		if(0<P)  fprintf(fh, "#include <stdio.h>\n#include <stdlib.h>\n");
+		if(0<sellc)  fprintf(fh, "#if defined(__AVX2__)\n#include <immintrin.h>\n#endif\n");
+	}
+	fprintf(fh, "\n");
+	fprintf(fh, "#define NCC_N   %ld\n", N);
+	fprintf(fh, "#define NCC_E   %ld\n", E);
+	fprintf(fh, "#define NCC_W   %ld\n", W);
+	fprintf(fh, "#define NCC_NX  %ld\n", NX);
+	fprintf(fh, "#define NCC_NY  %ld\n", NY);
+	fprintf(fh, "#define NCC_L   %ld\n", lvl->L);
+	fprintf(fh, "#define NCC_A   %ld\n", mem.A);
+	if(bat)  fprintf(fh, "#define NCC_BATCH  %ld\n", batch);
+	if(0<sellc)  fprintf(fh, "#define NCC_C   %ld\n#define NCC_SS  %ld\n#define NCC_WS  %ld\n", sellc,SS,WS);
+	if(0<P){
+		fprintf(fh, "#if !defined(NCC_CSR_PATH)\n#define NCC_CSR_PATH  \"%s\"\n#endif\n", csrpath);
+		fprintf(fh, "#define NCC_CSR_BDIM  %luull\n#define NCC_CSR_CHK   0x%016lxull\n", csrh.bdim,csrh.chk);
+	}
+	fprintf(fh, "#if !defined(NCC_SWISH_BETA)\n#define NCC_SWISH_BETA  1.0f\n#endif\n\n");
+	if(split)  fprintf(fh, "#pragma GCC visibility push(hidden)\n");
+	if(bat)           nirtu_decl(fh,fp,split, "float n[NCC_A][NCC_BATCH] __attribute__((aligned(64)));\n");
+	else if(0<sellc)  nirtu_decl(fh,fp,split, "float n[NCC_A+1];  // n[NCC_A] stays 0: the padding of the SELL slices reads it\n");
+	else              nirtu_decl(fh,fp,split, "float n[NCC_A];\n");
+	if(grad){  nirtu_decl(fh,fp,split, "float z[NCC_N];\n");  nirtu_decl(fh,fp,split, "float g[NCC_N];  // DL/Dn[j], and then DL/Dz[j], ie. the delta of nj\n");  }
+	fprintf(fh, "\n");
+	int vec=0;  mfor(f,0,7)  vec |= fs[f] && nir_fvec(f);
+	if(vec && !rt)  nccrt_act(fh);
+	static const char* fnames[] = {"identity","sigmoid","tanh","relu","silu","gelu","swish"};
+	mfor(f,0,7){
+		if(!fs[f])  continue;
+		if(     f==0)  fprintf(fh, "static inline float ncc_f0(float x){  return x;                                 }  // identity\n");
+		else if(f==3)  fprintf(fh, "static inline float ncc_f3(float x){  return x<0.0f ? 0.0f : x;                 }  // relu\n");
+		else           fprintf(fh, "static inline float ncc_f%ld(float x){  return f32_act1(%ld,NCC_SWISH_BETA,x);  }  // %s\n", f,f,fnames[f]);
+	}
+	fprintf(fh, "\n");
+	if(grad){  // the derivative of fj at the pre-activation z, given the activation n = fj(z)
+		mfor(f,0,7){
+			if(!fs[f])  continue;
+			if(     f==0)  fprintf(fh, "static inline float ncc_d0(float z,float n){  return 1.0f;                            }  // identity\n");
+			else if(f==3)  fprintf(fh, "static inline float ncc_d3(float z,float n){  return 0.0f<z ? 1.0f : 0.0f;            }  // relu\n");
+			else           fprintf(fh, "static inline float ncc_d%ld(float z,float n){  return f32_dact1(%ld,NCC_SWISH_BETA,z);  }  // %s\n", f,f,fnames[f]);
+		}
+		fprintf(fh, "\n");
+	}
+	if(0<BN && bat){
+		fprintf(fh, "// y[r][b] = SUM[c, a[r*k+c]*x[c][b]] for a row-major m x k matrix a, ie. a GEMM w/ the batch as the columns. a[r*k+c] is loaded once and broadcast over the batch\n");
+		fprintf(fh, "// 4 rows at a time: each x[c] is loaded once for 4 rows, and the 4 rows are 4 independent FMA chains, so a small batch isn't bound by the FMA latency\n");
+		fprintf(fh, "static inline void ncc_gemm(int m,int k, const float* restrict a, float (*restrict x)[NCC_BATCH], float (*restrict y)[NCC_BATCH]){\n");
+		fprintf(fh, "\tint r=0;\n");
+		fprintf(fh, "\tfor(; r+4<=m; r+=4, a+=4*k){\n");
+		fprintf(fh, "\t\tfloat s0[NCC_BATCH]={0.0f}, s1[NCC_BATCH]={0.0f}, s2[NCC_BATCH]={0.0f}, s3[NCC_BATCH]={0.0f};\n");
+		fprintf(fh, "\t\tfor(int c=0; c<k; ++c){\n");
+		fprintf(fh, "\t\t\tfloat a0=a[c], a1=a[k+c], a2=a[2*k+c], a3=a[3*k+c];\n");
+		fprintf(fh, "\t\t\tfor(int b=0; b<NCC_BATCH; ++b){  float xb=x[c][b];  s0[b] += a0*xb;  s1[b] += a1*xb;  s2[b] += a2*xb;  s3[b] += a3*xb;  }\n");
+		fprintf(fh, "\t\t}\n");
+		fprintf(fh, "\t\tfor(int b=0; b<NCC_BATCH; ++b){  y[r][b]=s0[b];  y[r+1][b]=s1[b];  y[r+2][b]=s2[b];  y[r+3][b]=s3[b];  }\n");
+		fprintf(fh, "\t}\n");
+		fprintf(fh, "\tfor(; r<m; ++r, a+=k){\n");
+		fprintf(fh, "\t\tfloat s[NCC_BATCH]={0.0f};\n");
+		fprintf(fh, "\t\tfor(int c=0; c<k; ++c)\n");
+		fprintf(fh, "\t\t\tfor(int b=0; b<NCC_BATCH; ++b)  s[b] += a[c]*x[c][b];\n");
+		fprintf(fh, "\t\tfor(int b=0; b<NCC_BATCH; ++b)  y[r][b] = s[b];\n");
+		fprintf(fh, "\t}\n");
+		fprintf(fh, "}\n\n");
+	}else if(0<BN){
+		fprintf(fh, "// y[r] = SUM[c, a[r*k+c]*x[c]] for a row-major m x k matrix a. 8 partial sums per row, so the compiler can vectorize it w/o reassociating\n");
+		fprintf(fh, "static inline void ncc_gemv(int m,int k, const float* restrict a, const float* restrict x, float* restrict y){\n");
+		fprintf(fh, "\tfor(int r=0; r<m; ++r, a+=k){\n");
+		fprintf(fh, "\t\tfloat s[8]={0.0f};  int c=0;\n");
+		fprintf(fh, "\t\tfor(; c+8<=k; c+=8)\n");
+		fprintf(fh, "\t\t\tfor(int t=0; t<8; ++t)  s[t] += a[c+t]*x[c+t];\n");
+		fprintf(fh, "\t\tfor(; c<k; ++c)  s[0] += a[c]*x[c];\n");
+		fprintf(fh, "\t\ty[r] = ((s[0]+s[4])+(s[1]+s[5])) + ((s[2]+s[6])+(s[3]+s[7]));\n");
+		fprintf(fh, "\t}\n");
+		fprintf(fh, "}\n\n");
+	}
+	if(0<BN && grad){
+		fprintf(fh, "// the bwd of ncc_gemv, given the deltas dy of y: dx[c] += SUM[r, a[r*k+c]*dy[r]], and da[r*k+c] += dy[r]*x[c]\n");
+		fprintf(fh, "static inline void ncc_gemv_bwd(int m,int k, const float* restrict a, const float* restrict x, const float* restrict dy, float* restrict da, float* restrict dx){\n");
+		fprintf(fh, "\tfor(int r=0; r<m; ++r, a+=k, da+=k){\n");
+		fprintf(fh, "\t\tfloat d=dy[r];\n");
+		fprintf(fh, "\t\tfor(int c=0; c<k; ++c){  dx[c] += a[c]*d;  da[c] += d*x[c];  }\n");
+		fprintf(fh, "\t}\n");
+		fprintf(fh, "}\n\n");
+	}
+	if(0<vidim(cvs) && bat){
+		fprintf(fh, "// y[oy*Wo+ox][b] = SUM[c,dy,dx, x[(c*Hi+iy)*Wi+ix][b]*w[(c*K+dy)*K+dx]], as below, for every sample b of the batch\n");
+		fprintf(fh, "static inline void ncc_conv(int Ho,int Wo, int C,int Hi,int Wi, int K,int s,int p, float (*restrict x)[NCC_BATCH], const float* restrict w, float (*restrict y)[NCC_BATCH]){\n");
+		fprintf(fh, "\tfor(int oy=0; oy<Ho; ++oy)\n");
+		fprintf(fh, "\t\tfor(int ox=0; ox<Wo; ++ox){\n");
+		fprintf(fh, "\t\t\tfloat a[NCC_BATCH]={0.0f};\n");
+		fprintf(fh, "\t\t\tfor(int c=0; c<C; ++c)\n");
+		fprintf(fh, "\t\t\t\tfor(int dy=0; dy<K; ++dy){\n");
+		fprintf(fh, "\t\t\t\t\tint iy=oy*s+dy-p;  if(iy<0 || Hi<=iy)  continue;\n");
+		fprintf(fh, "\t\t\t\t\tfor(int dx=0; dx<K; ++dx){\n");
+		fprintf(fh, "\t\t\t\t\t\tint ix=ox*s+dx-p;  if(ix<0 || Wi<=ix)  continue;\n");
+		fprintf(fh, "\t\t\t\t\t\tfloat wt=w[(c*K+dy)*K+dx];  const float* xt=x[(c*Hi+iy)*Wi+ix];\n");
+		fprintf(fh, "\t\t\t\t\t\tfor(int b=0; b<NCC_BATCH; ++b)  a[b] += xt[b]*wt;\n");
+		fprintf(fh, "\t\t\t\t\t}\n");
+		fprintf(fh, "\t\t\t\t}\n");
+		fprintf(fh, "\t\t\tfor(int b=0; b<NCC_BATCH; ++b)  y[oy*Wo+ox][b] = a[b];\n");
+		fprintf(fh, "\t\t}\n");
+		fprintf(fh, "}\n\n");
+	}else if(0<vidim(cvs)){
+		fprintf(fh, "// y[oy*Wo+ox] = SUM[c,dy,dx, x[(c*Hi+iy)*Wi+ix]*w[(c*K+dy)*K+dx]] for iy=oy*s+dy-p, ix=ox*s+dx-p, over the in-bounds part of each K x K window\n");
+		fprintf(fh, "static inline void ncc_conv(int Ho,int Wo, int C,int Hi,int Wi, int K,int s,int p, const float* restrict x, const float* restrict w, float* restrict y){\n");
+		fprintf(fh, "\tfor(int oy=0; oy<Ho; ++oy)\n");
+		fprintf(fh, "\t\tfor(int ox=0; ox<Wo; ++ox){\n");
+		fprintf(fh, "\t\t\tfloat a=0.0f;\n");
+		fprintf(fh, "\t\t\tfor(int c=0; c<C; ++c)\n");
+		fprintf(fh, "\t\t\t\tfor(int dy=0; dy<K; ++dy){\n");
+		fprintf(fh, "\t\t\t\t\tint iy=oy*s+dy-p;  if(iy<0 || Hi<=iy)  continue;\n");
+		fprintf(fh, "\t\t\t\t\tfor(int dx=0; dx<K; ++dx){\n");
+		fprintf(fh, "\t\t\t\t\t\tint ix=ox*s+dx-p;  if(ix<0 || Wi<=ix)  continue;\n");
+		fprintf(fh, "\t\t\t\t\t\ta += x[(c*Hi+iy)*Wi+ix]*w[(c*K+dy)*K+dx];\n");
+		fprintf(fh, "\t\t\t\t\t}\n");
+		fprintf(fh, "\t\t\t\t}\n");
+		fprintf(fh, "\t\t\ty[oy*Wo+ox] = a;\n");
+		fprintf(fh, "\t\t}\n");
+		fprintf(fh, "}\n\n");
+	}
+	if(0<vidim(cvs) && grad){
+		fprintf(fh, "// the bwd of ncc_conv, given the deltas dy of y: every tap x*w of the fwd adds dy*w to dx and dy*x to dw\n");
+		fprintf(fh, "static inline void ncc_conv_bwd(int Ho,int Wo, int C,int Hi,int Wi, int K,int s,int p, const float* restrict x, const float* restrict w, const float* restrict dy, float* restrict dw, float* restrict dx){\n");
+		fprintf(fh, "\tfor(int oy=0; oy<Ho; ++oy)\n");
+		fprintf(fh, "\t\tfor(int ox=0; ox<Wo; ++ox){\n");
+		fprintf(fh, "\t\t\tfloat d=dy[oy*Wo+ox];\n");
+		fprintf(fh, "\t\t\tfor(int c=0; c<C; ++c)\n");
+		fprintf(fh, "\t\t\t\tfor(int ky=0; ky<K; ++ky){\n");
+		fprintf(fh, "\t\t\t\t\tint iy=oy*s+ky-p;  if(iy<0 || Hi<=iy)  continue;\n");
+		fprintf(fh, "\t\t\t\t\tfor(int kx=0; kx<K; ++kx){\n");
+		fprintf(fh, "\t\t\t\t\t\tint ix=ox*s+kx-p;  if(ix<0 || Wi<=ix)  continue;\n");
+		fprintf(fh, "\t\t\t\t\t\tdx[(c*Hi+iy)*Wi+ix] += w[(c*K+ky)*K+kx]*d;\n");
+		fprintf(fh, "\t\t\t\t\t\tdw[(c*K+ky)*K+kx]   += d*x[(c*Hi+iy)*Wi+ix];\n");
+		fprintf(fh, "\t\t\t\t\t}\n");
+		fprintf(fh, "\t\t\t\t}\n");
+		fprintf(fh, "\t\t}\n");
+		fprintf(fh, "}\n\n");
+	}
+
+	if(0<sellc){
+		if(0<SS){
+			char* sc = split ? "" : "static ";  // the tables are in TU 0 only
+			if(split)  fprintf(fh, "extern const unsigned ncc_sp[NCC_SS+1];\nextern const int ncc_si[NCC_WS] __attribute__((aligned(64)));\nextern const unsigned ncc_wp[NCC_WS];\nextern const int ncc_so[NCC_SS*NCC_C];\n");
+			fprintf(fp, "%sconst unsigned ncc_sp[NCC_SS+1] = {", sc);  // slice s is the slots ncc_sp[s] .. ncc_sp[s+1]-1
+			mfor(q,0,SS+1)  fprintf(fp, "%s%lu,", q%32 ? "" : "\n\t", sell.sp[q]);
+			fprintf(fp, "\n};\n%sconst int ncc_si[NCC_WS] __attribute__((aligned(64))) = {", sc);  // the arena slot of the in -neuron of each slot
+			mfor(q,0,WS)    fprintf(fp, "%s%u,", q%32 ? "" : "\n\t", sell.si[q]==0xffffffff ? (u32)mem.A : a[sell.si[q]]);
+			fprintf(fp, "\n};\n%sconst unsigned ncc_wp[NCC_WS] = {", sc);  // the weight of each slot
+			mfor(q,0,WS)    fprintf(fp, "%s%lu,", q%32 ? "" : "\n\t", sell.wp[q]==0xffffffffffffffffull ? (u64)0xffffffff : sell.wp[q]);
+			fprintf(fp, "\n};\n%sconst int ncc_so[NCC_SS*NCC_C] = {", sc);  // the arena slot of the out-neuron of each lane
+			mfor(q,0,SS*sellc)  fprintf(fp, "%s%u,", q%32 ? "" : "\n\t", sell.so[q]==0xffffffff ? (u32)mem.A : a[sell.so[q]]);
+			fprintf(fp, "\n};\n");
+			nirtu_decl(fh,fp,split, "float ncc_ws[NCC_WS] __attribute__((aligned(64)));\n");
+			fprintf(fh, "\n");
+			fprintf(fh, "// t[c] = SUM[col, n[ncc_si[q]]*ncc_ws[q]] for q = ncc_sp[s]+col*NCC_C+c, over the columns of slice s. lane c computes the c-th neuron of the slice: 1 gather of NCC_C activations and 1 contiguous load of NCC_C weights per column\n");
+			fprintf(fh, "static inline void ncc_sell(int s, float* restrict t){\n");
+			fprintf(fh, "\tconst int* restrict si=ncc_si+ncc_sp[s];  const float* restrict ws=ncc_ws+ncc_sp[s];  int k=(ncc_sp[s+1]-ncc_sp[s])/NCC_C;\n");
+			fprintf(fh, "#if NCC_C==8 && defined(__AVX2__) && defined(__FMA__)\n");
+			fprintf(fh, "\t__m256 a=_mm256_setzero_ps();\n");
+			fprintf(fh, "\tfor(int col=0; col<k; ++col, si+=8, ws+=8)  a = _mm256_fmadd_ps(_mm256_i32gather_ps(n, _mm256_load_si256((const __m256i*)si), 4), _mm256_load_ps(ws), a);\n");
+			fprintf(fh, "\t_mm256_storeu_ps(t,a);\n");
+			fprintf(fh, "#elif NCC_C==16 && defined(__AVX512F__)\n");
+			fprintf(fh, "\t__m512 a=_mm512_setzero_ps();\n");
+			fprintf(fh, "\tfor(int col=0; col<k; ++col, si+=16, ws+=16)  a = _mm512_fmadd_ps(_mm512_i32gather_ps(_mm512_load_si512(si), n, 4), _mm512_load_ps(ws), a);\n");
+			fprintf(fh, "\t_mm512_storeu_ps(t,a);\n");
+			fprintf(fh, "#else\n");
+			fprintf(fh, "\tfor(int c=0; c<NCC_C; ++c)  t[c]=0.0f;\n");
+			fprintf(fh, "\tfor(int col=0; col<k; ++col, si+=NCC_C, ws+=NCC_C)\n");
+			fprintf(fh, "\t\tfor(int c=0; c<NCC_C; ++c)  t[c] += n[si[c]]*ws[c];\n");
+			fprintf(fh, "#endif\n");
+			fprintf(fh, "}\n\n");
+		}
+		fprintf(fp, "// pack the weights of the SELL slices: ncc_ws[q] is w[ncc_wp[q]], or 0 for the padding. call it before fwd(), and again whenever w changes\n");
+		fprintf(fp, "void wpack(const float* w){\n");
+		if(0<SS)  fprintf(fp, "\tfor(int q=0; q<NCC_WS; ++q)  ncc_ws[q] = ncc_wp[q]==0xffffffffu ? 0.0f : w[ncc_wp[q]];\n");
+		fprintf(fp, "}\n\n");
+	}
+
+	if(0<P){
+		nirtu_decl(fh,fp,split, "const unsigned *ncc_o, *ncc_e, *ncc_w, *ncc_i, *ncc_x, *ncc_y;  // the CSR arrays, in the .csr\n");
+		fprintf(fh, "\n");
+		fprintf(fp, "// read the .csr at path, and check it's the one this file was generated w/. @ret 0 on success\n");
+		fprintf(fp, "int ncc_init(const char* path){\n");
+		fprintf(fp, "\tFILE* fp = fopen(path,\"rb\");  if(fp==NULL)  return -1;\n");
+		fprintf(fp, "\tunsigned long long* h = aligned_alloc(64,NCC_CSR_BDIM);\n");
+		fprintf(fp, "\tint ok = h!=NULL && fread(h,1,NCC_CSR_BDIM,fp)==NCC_CSR_BDIM && fgetc(fp)==EOF;\n");
+		fprintf(fp, "\tfclose(fp);\n");
+		fprintf(fp, "\tif(!ok || h[0]!=0x%016llxull || h[1]!=%d || h[2]!=NCC_CSR_BDIM || h[13]!=NCC_CSR_CHK){  free(h);  return -1;  }  // magic, version, size, checksum\n", CSR_MAGIC,CSR_VERSION);
+		fprintf(fp, "\tconst char* d = (const char*)h;\n");
+		fprintf(fp, "\tncc_o=(const unsigned*)(d+h[7]);  ncc_e=(const unsigned*)(d+h[8]);  ncc_w=(const unsigned*)(d+h[9]);  ncc_i=(const unsigned*)(d+h[10]);  ncc_x=(const unsigned*)(d+h[11]);  ncc_y=(const unsigned*)(d+h[12]);\n");
+		fprintf(fp, "\treturn 0;\n");
+		fprintf(fp, "}\n\n");
+		if(bat){
+			fprintf(fh, "// r[b] = SUM[t, n[ncc_i[t]][b]*w[ncc_w[p]+t-ncc_e[p]]] over the edges t of CSR neuron p, for every sample b of the batch\n");
+			fprintf(fh, "static inline void ncc_dot(int p, const float* restrict w, float* restrict r){\n");
+			fprintf(fh, "\tfloat s[NCC_BATCH]={0.0f};  const float* restrict wp=w+ncc_w[p]-ncc_e[p];\n");
+			fprintf(fh, "\tfor(unsigned t=ncc_e[p]; t<ncc_e[p+1]; ++t){  float wt=wp[t];  const float* nt=n[ncc_i[t]];  for(int b=0; b<NCC_BATCH; ++b)  s[b] += nt[b]*wt;  }\n");
+			fprintf(fh, "\tfor(int b=0; b<NCC_BATCH; ++b)  r[b] = s[b];\n");
+			fprintf(fh, "}\n\n");
+		}else{
+			fprintf(fh, "// SUM[t, n[ncc_i[t]]*w[ncc_w[p]+t-ncc_e[p]]] over the edges t of CSR neuron p\n");
+			fprintf(fh, "static inline float ncc_dot(int p, const float* w){\n");
+			fprintf(fh, "\tfloat s=0.0f;  const float* wp=w+ncc_w[p]-ncc_e[p];\n");
+			fprintf(fh, "\tfor(unsigned t=ncc_e[p]; t<ncc_e[p+1]; ++t)  s += n[ncc_i[t]]*wp[t];\n");
+			fprintf(fh, "\treturn s;\n");
+			fprintf(fh, "}\n\n");
+		}
+		fprintf(fh, "// CSR neurons p0 .. p1-1, whose activation fn is fF. not inlined: its call sites are 1 per loop level and activation fn, and inlining them all makes the C compiler crawl\n");
+		fprintf(fh, "// the vector activation fns take 64 neurons (or a row of the batch) at a time\n");
+		fprintf(fh, "__attribute__((noinline)) static void ncc_csr(int p0,int p1, int F, const float* w){\n");
+		fprintf(fh, "\tswitch(F){\n");
+		mfor(f,0,7){
+			if(!fs[f])  continue;
+			if(nir_fvec(f)){
+				if(bat)        fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; ++p){  float* r=n[ncc_o[p]];  ncc_dot(p,w,r);  f32_act(%ld,NCC_SWISH_BETA, NCC_BATCH,r,r);  }  break;\n", f,f);
+				else if(grad)  fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; p+=64){  int m=p1-p<64 ? p1-p : 64;  float t[64];  for(int q=0; q<m; ++q)  t[q] = z[ncc_o[p+q]] = ncc_dot(p+q,w);  f32_act(%ld,NCC_SWISH_BETA, m,t,t);  for(int q=0; q<m; ++q)  n[ncc_o[p+q]] = t[q];  }  break;\n", f,f);
+				else           fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; p+=64){  int m=p1-p<64 ? p1-p : 64;  float t[64];  for(int q=0; q<m; ++q)  t[q] = ncc_dot(p+q,w);  f32_act(%ld,NCC_SWISH_BETA, m,t,t);  for(int q=0; q<m; ++q)  n[ncc_o[p+q]] = t[q];  }  break;\n", f,f);
+				continue;
+			}
+			if(bat)        fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; ++p){  float* r=n[ncc_o[p]];  ncc_dot(p,w,r);  for(int b=0; b<NCC_BATCH; ++b)  r[b] = ncc_f%ld(r[b]);  }  break;\n", f,f);
+			else if(grad)  fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; ++p){  int o=ncc_o[p];  n[o] = ncc_f%ld(z[o] = ncc_dot(p,w));  }  break;\n", f,f);
+			else           fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; ++p)  n[ncc_o[p]] = ncc_f%ld(ncc_dot(p,w));  break;\n", f,f);
+		}
+		fprintf(fh, "\t}\n");
+		fprintf(fh, "}\n\n");
+		if(grad){
+			fprintf(fh, "// the bwd of ncc_dot, given the delta d of CSR neuron p: every edge t adds w*d to the delta of its in-neuron, and d*n to its weight\n");
+			fprintf(fh, "static inline void ncc_dot_bwd(int p, float d, const float* w, float* dw){\n");
+			fprintf(fh, "\tconst float* wp=w+ncc_w[p]-ncc_e[p];  float* dwp=dw+ncc_w[p]-ncc_e[p];\n");
+			fprintf(fh, "\tfor(unsigned t=ncc_e[p]; t<ncc_e[p+1]; ++t){  unsigned i=ncc_i[t];  g[i] += wp[t]*d;  dwp[t] += d*n[i];  }\n");
+			fprintf(fh, "}\n\n");
+			fprintf(fh, "// the bwd of ncc_csr\n");
+			fprintf(fh, "__attribute__((noinline)) static void ncc_csr_bwd(int p0,int p1, int F, const float* w, float* dw){\n");
+			fprintf(fh, "\tswitch(F){\n");
+			mfor(f,0,7){
+				if(!fs[f])  continue;
+				if(nir_fvec(f))  fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; p+=64){  int m=p1-p<64 ? p1-p : 64;  float t[64], u[64];  for(int q=0; q<m; ++q){  t[q]=g[ncc_o[p+q]];  u[q]=z[ncc_o[p+q]];  }  f32_dact(%ld,NCC_SWISH_BETA, m,t,u);  for(int q=0; q<m; ++q)  ncc_dot_bwd(p+q, g[ncc_o[p+q]] = t[q], w,dw);  }  break;\n", f,f);
+				else             fprintf(fh, "\t\tcase %ld:  for(int p=p0; p<p1; ++p){  int o=ncc_o[p];  ncc_dot_bwd(p, g[o] *= ncc_d%ld(z[o],n[o]), w,dw);  }  break;\n", f,f);
+			}
+			fprintf(fh, "\t}\n");
+			fprintf(fh, "}\n\n");
+		}
+	}
+
+	char* psig = bat ? "const float* restrict x, const float* restrict w" : "const float* x, const float* w";  // the parts of a split fwd()
+	if(split){  // the parts, and then the end of the header
+		mfor(t,0,tu.T)  fprintf(fh, "void ncc_fwd%ld(%s);\n", t,psig);
+		if(grad)  mfor(t,0,tu.T)  fprintf(fh, "void ncc_bwd%ld(const float* w, float* dw);\n", t);
+		fprintf(fh, "#pragma GCC visibility pop\n");
+		nnchk(fclose(fh)!=0, "can't write \x1b[92m%s\x1b[0m: %s", hpath,strerror(errno));
+	}
+	u32* cost = malloc(Bsize(u32)*mmax(N,1));  // the size of the fwd code of each neuron (see @blk1 nirtu)
+	mfor(j,0,N){
+		if(nir_idim(nir,j)==0)  cost[j] = P==0;
+		else if((0<sellc && sell.in[j]) || (csr.lp[lvl->lvl[j]] && loose[j]))  cost[j] = 0;
+		else if(S[j]!=0xffffffff)  cost[j] = cvs[S[j]].j==j;
+		else if(B[j]!=0xffffffff)  cost[j] = blks[B[j]].j==j;
+		else                       cost[j] = 1+nir_idim(nir,j);
+	}
+	nirtu_begin(&tu, cost,N);
+	FILE* fq = fp;  // the file of the current part
+	if(split)  fprintf(fp, "void ncc_fwd0(%s){\n", psig);
+	else       nirgen_fwd_head(fp, bat, P);
+	i64 k=0, g=0, c=0;
+	u32* js[7];  mfor(f,0,7)  js[f]=vini(u32);  // the loose neurons of a level w/ a vector activation fn, per activation fn
+	mfor(l,0,lvl->L){  // level 0 holds exactly the input neurons, in ascending order
+		fprintf(fq, "\t// level %ld: %lu neurons\n", l,lvl->off[l+1]-lvl->off[l]);
+		for(; c<vidim(csr.grps) && csr.grps[c].l==l; ++c){  // the CSR loops of the level, 1 per activation fn
+			nircsrgrp_t* grp = &csr.grps[c];
+			fprintf(fq, "\tncc_csr(%lu,%lu, %u, w);\n", grp->p0,grp->p1, grp->f);
+		}
+		for(; 0<sellc && g<vidim(sell.grps) && sell.grps[g].l==l; ++g){  // the SELL slices of the level come 1st. the full ones in a loop, and the last one on its own if it's partial
+			nirsellgrp_t* grp = &sell.grps[g];
+			u64 s1 = grp->m==sellc ? grp->s1 : grp->s1-1;
+			char* st = grad ? "{  int o=ncc_so[%s];  n[o] = ncc_f%u(z[o] = t[c]);  }" : "n[ncc_so[%s]] = ncc_f%u(t[c]);";
+			char  sv[64] = "";  // the vector activation fns take a whole slice, from t to u
+			if(nir_fvec(grp->f)){
+				st = grad ? "{  int o=ncc_so[%s];  z[o] = t[c];  n[o] = u[c];  }" : "n[ncc_so[%s]] = u[c];";
+				snprintf(sv,sizeof(sv), "float u[NCC_C];  f32_act(%u,NCC_SWISH_BETA, NCC_C,u,t);  ", grp->f);
+			}
+			if(grp->s0<s1){
+				fprintf(fq, "\tfor(int s=%lu; s<%lu; ++s){  float t[NCC_C];  ncc_sell(s,t);  %sfor(int c=0; c<NCC_C; ++c)  ", grp->s0,s1, sv);
+				fprintf(fq, st, "s*NCC_C+c", grp->f);  fprintf(fq, "  }\n");
+			}
+			if(s1<grp->s1){
+				char ix[64];  snprintf(ix,sizeof(ix), "%lu+c", s1*sellc);
+				fprintf(fq, "\t{  float t[NCC_C];  ncc_sell(%lu,t);  %sfor(int c=0; c<%u; ++c)  ", s1, sv, grp->m);
+				fprintf(fq, st, ix, grp->f);  fprintf(fq, "  }\n");
+			}
+		}
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){
+			u32 j = lvl->idx[p];
+			if(nirtu_cut(&tu,j)){  // the deferred neurons stay in their part
+				mfor(f,0,7){
+					if(0<vidim(js[f]))  nirgen_vec(fq, nir,a,woff, grad, f,js[f]);
+					vkeepn(js[f],0);
+				}
+				fq = nirtu_next(&tu, "fwd",psig);
+			}
+			if(0<sellc && sell.in[j])  continue;
+			if(csr.lp[l] && loose[j])  continue;
+			if(nir_idim(nir,j)==0 && 0<P)   continue;
+			if(nir_idim(nir,j)==0 && bat){  fprintf(fq, "\tfor(int b=0; b<NCC_BATCH; ++b)  n[%u][b] = x[%ld*NCC_BATCH+b];\n", a[j],k++);  continue;  }
+			if(nir_idim(nir,j)==0){         fprintf(fq, "\tn[%u] = x[%ld];\n", a[j],k++);  continue;  }
+			if(S[j]!=0xffffffff){  // so is a conv plane
+				nirconv_t* cv = &cvs[S[j]];
+				if(cv->j!=j)  continue;
+				fprintf(fq, "\tncc_conv(%u,%u, %u,%u,%u, %u,%u,%u, n+%u, w+%lu, %s+%u);\n", cv->Ho,cv->Wo, cv->C,cv->Hi,cv->Wi, cv->K,cv->s,cv->p, a[cv->i], woff[j], z,a[cv->j]);
+				if(nir_fvec(nir->F[j]) && bat)  fprintf(fq, "\tf32_act(%u,NCC_SWISH_BETA, %u*NCC_BATCH,n[%u],n[%u]);\n", nir->F[j], cv->Ho*cv->Wo, a[cv->j],a[cv->j]);
+				else if(nir_fvec(nir->F[j]))    fprintf(fq, "\tf32_act(%u,NCC_SWISH_BETA, %u,n+%u,%s+%u);\n", nir->F[j], cv->Ho*cv->Wo, a[cv->j], z,a[cv->j]);
+				else if(bat)  fprintf(fq, "\tfor(int r=%u; r<%u; ++r)  for(int b=0; b<NCC_BATCH; ++b)  n[r][b] = ncc_f%u(n[r][b]);\n", a[cv->j],a[cv->j]+cv->Ho*cv->Wo, nir->F[j]);
+				else          fprintf(fq, "\tfor(int r=%u; r<%u; ++r)  n[r] = ncc_f%u(%s[r]);\n", a[cv->j],a[cv->j]+cv->Ho*cv->Wo, nir->F[j], z);
+				continue;
+			}
+			if(B[j]!=0xffffffff){  // a block is emitted at its 1st neuron, which comes first in its level
+				nirblk_t* blk = &blks[B[j]];
+				if(blk->j!=j)  continue;
+				if(bat){
+					fprintf(fq, "\tncc_gemm(%u,%u, w+%lu, n+%u, n+%u);\n", blk->m,blk->k, woff[j], a[blk->i], a[blk->j]);
+					if(nir_fvec(nir->F[j]))  fprintf(fq, "\tf32_act(%u,NCC_SWISH_BETA, %u*NCC_BATCH,n[%u],n[%u]);\n", nir->F[j], blk->m, a[blk->j],a[blk->j]);
+					else                     fprintf(fq, "\tfor(int r=%u; r<%u; ++r)  for(int b=0; b<NCC_BATCH; ++b)  n[r][b] = ncc_f%u(n[r][b]);\n", a[blk->j],a[blk->j]+blk->m, nir->F[j]);
+				}else{
+					fprintf(fq, "\tncc_gemv(%u,%u, w+%lu, n+%u, %s+%u);\n", blk->m,blk->k, woff[j], a[blk->i], z,a[blk->j]);
+					if(nir_fvec(nir->F[j]))  fprintf(fq, "\tf32_act(%u,NCC_SWISH_BETA, %u,n+%u,%s+%u);\n", nir->F[j], blk->m, a[blk->j], z,a[blk->j]);
+					else                     fprintf(fq, "\tfor(int r=%u; r<%u; ++r)  n[r] = ncc_f%u(%s[r]);\n", a[blk->j],a[blk->j]+blk->m, nir->F[j], z);
+				}
+				continue;
+			}
+			if(bat && nir_fvec(nir->F[j])){
+				fprintf(fq, "\tfor(int b=0; b<NCC_BATCH; ++b)  n[%u][b] =", a[j]);
+				for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e) fprintf(fq, " +n[%u][b]*w[%lu]", a[nir->Iidx[e]],woff[j]+(e-nir->Ioff[j]));
+				fprintf(fq, ";\n\tf32_act(%u,NCC_SWISH_BETA, NCC_BATCH,n[%u],n[%u]);\n", nir->F[j], a[j],a[j]);  // after the loop, so on a line of its own
+				continue;
+			}
+			if(bat){
+				fprintf(fq, "\tfor(int b=0; b<NCC_BATCH; ++b)  n[%u][b] = ncc_f%u(", a[j],nir->F[j]);
+				for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e) fprintf(fq, " +n[%u][b]*w[%lu]", a[nir->Iidx[e]],woff[j]+(e-nir->Ioff[j]));
+				fprintf(fq, ");\n");
+				continue;
+			}
+			if(nir_fvec(nir->F[j])){  vpush(js[nir->F[j]], j);  continue;  }  // at the end of the level, w/ the other neurons of its activation fn
+			fprintf(fq, "\tn[%u] = ncc_f%u(", a[j],nir->F[j]);
+			if(grad)  fprintf(fq, "z[%u] =", j);
+			for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e) fprintf(fq, " +n[%u]*w[%lu]", a[nir->Iidx[e]],woff[j]+(e-nir->Ioff[j]));
+			fprintf(fq, ");\n");
+		}
+		mfor(f,0,7){  // the neurons of a level don't read each other, and don't share slots, so their writes can wait till the end of it
+			if(0<vidim(js[f]))  nirgen_vec(fq, nir,a,woff, grad, f,js[f]);
+			vkeepn(js[f],0);
+		}
+	}
+	if(split){  // the driver
+		fprintf(fq, "}\n\n");
+		nirgen_fwd_head(fp, bat, P);
+		mfor(t,0,tu.t+1)  fprintf(fp, "\tncc_fwd%ld(x,w);\n", t);
+	}
+	k=0;
+	if(0<P && bat)  fprintf(fp, "\tfor(int k=0; k<NCC_NY; ++k)  for(int b=0; b<NCC_BATCH; ++b)  y[k*NCC_BATCH+b] = n[ncc_y[k]][b];\n");
+	else if(0<P)    fprintf(fp, "\tfor(int k=0; k<NCC_NY; ++k)  y[k] = n[ncc_y[k]];\n");
+	else mfor(j,0,N)
+		if(nir_idim(nir,j)!=0 && nir_odim(nir,j)==0){
+			if(bat)  fprintf(fp, "\tfor(int b=0; b<NCC_BATCH; ++b)  y[%ld*NCC_BATCH+b] = n[%u][b];\n", k++,a[j]);
+			else     fprintf(fp, "\ty[%ld] = n[%u];\n", k++,a[j]);
+		}
+	fprintf(fp, "}\n");
+	mfor(f,0,7)  vend(js[f]);
+	if(grad)  nirgen_bwd(&tu, nir,lvl, cvs,S, blks,B, woff, loose,&csr);
+	nnchk(fclose(fp)!=0, "can't write \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+	mfor(t,1,tu.T)  nnchk(fclose(tu.fps[t])!=0, "can't write TU \x1b[34m%ld \x1b[0mof \x1b[92m%s\x1b[0m: %s", t,path,strerror(errno));
+	free(tu.fps);
+	free(hpath);
+	free(cost);
+	nnlogf("\x1b[92mnirgen  \x1b[0mN \x1b[34m%'ld  \x1b[0mE \x1b[34m%'ld  \x1b[0mNX \x1b[34m%'ld  \x1b[0mNY \x1b[34m%'ld  \x1b[0mL \x1b[34m%'ld  \x1b[0mB \x1b[34m%'ld \x1b[0m(\x1b[34m%'ld \x1b[0medges)  \x1b[0mS \x1b[34m%'ld \x1b[0m(\x1b[34m%'ld \x1b[0medges)  \x1b[0mW \x1b[34m%'ld  \x1b[0mA \x1b[34m%'ld \x1b[0m(\x1b[34m%'ld \x1b[0mruns)  \x1b[0mSELL \x1b[34m%'ld \x1b[0m(\x1b[34m%'ld \x1b[0mneurons)  \x1b[0mCSR \x1b[34m%'ld \x1b[0mlevels (\x1b[34m%'ld \x1b[0mneurons)  \x1b[0mbatch \x1b[34m%ld  \x1b[92m%s\x1b[0m\n", N,E,NX,NY,lvl->L,BN,BE,vidim(cvs),SE,W,mem.A,mem.G, SS,SN, CL,P, batch, path);
+	if(share)  free(woff);
+	free(csrpath);
+	nircsr_end(&csr);
+	free(loose);
+	nirsell_end(&sell);
+	nirmem_end(&mem);
+	free(B);
+	vend(blks);
+	free(S);
+	vend(cvs);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirdif: incremental builds, for searches that mutate a net a few edges at a time
+/*
+an architecture search (or a pruning loop) compiles 1 net per candidate, and a candidate is its parent plus or minus a handful of edges. -d emits the C in a layout where the code of a neuron depends on nothing but the neuron (its in-indices, its activation fn and its level), so a mutation only changes the code that it touches:
+	- every neuron has its own slot, n[j] (see @nirmem_ini w/ keep), and it reads its weights from w+ncc_wo[j], not from a literal offset, since 1 more edge on nj moves the weights of every neuron after it
+	- the schedule (see @blk1 nirtu) is cut into parts of NCC_DIF_EMAX edges, 1 TU each: a part ends when the next neuron doesn't fit, so the cuts up to the 1st change are the cuts of the parent
+	- the header is the same for every net (given the options), and TU 0 is the rest: fwd(), which copies x and y and calls the parts, and ncc_wo
+	- the header turns off gcc's SLP vectorizer: w/ the weights at run-time offsets, it can't prove that the loads of 2 edges are adjacent, so it searches for many times as long as the rest of -O2, and finds nothing, since every neuron reads other weights
+	- there are no blocks, conv planes, SELL slices or CSR loops, since they're 1 piece of code for many neurons, and there's no bwd-pass
+-D dir diffs the net against a -d entry of the -K cache, dir, which is the parent (its net.nab and net.lvl, ie. its graph and its levels):
+	- the changed neurons are the ones whose in-indices or activation fn differ, or that are new. levels only change downstream of them: the cone (the changed neurons, and all that's reachable from them through the out-index) is relevelized, and the rest keep their level. that's O[V] plus O[the edges of the cone], not O[V+E]
+	- a part of the new schedule is reused if it holds the same neurons, at the same levels, as the part of the parent w/ the same index, and none of them changed: its code is the same, so its .c and its object come from dir, and it isn't emitted or compiled
+	- so a candidate compiles the parts that its mutation touches and TU 0, and the parts after them only if the cone reaches them (or if moved levels shift the cuts)
+*/
+#define NCC_DIF_EMAX  0x800  // edges per part of -d: about as much gcc -O2 as a TU of -T w/ as many edges (see @NCC_UNROLL_EMAX)
+
+tdef{
+	i64 C;     // changed neurons
+	i64 K;     // neurons in their cone, changed ones included
+	u8* chg;   // [N] chg[j] is 1 if neuron nj changed
+	u8* cone;  // [N] cone[j] is 1 if nj is in the cone
+}nirdif_t;
+
+tdef{  // the head of net.lvl, followed by the level of each neuron, as N u32's
+	u64 opts;  // xxh64 of the options of the entry (see @nccache_ini): a parent must have the same, since its objects were compiled w/ them
+	u64 N;     // neurons
+	u64 T;     // TUs: TU 0, and then 1 per part
+	u64 B;     // the batch (see @nirbatch): a child of -B auto takes it, so its header is the same
+}nirdifh_t;
+
+fdef void nirdif_end(nirdif_t* dif){
+	if(dif==NULL) return;
+	free(dif->cone);  free(dif->chg);
+	*dif=(nirdif_t){0x00};
+}
+
+// @meta  O[V+E] diff the graph @nir against its parent @old: the changed neurons, and their cone, by a BFS through the out-index of @nir
+fdef void nirdif_ini(nir_t* old, nir_t* nir, nirdif_t* odif){
+	i64  N=nir->N, C=0, qn=0;
+	u8*  chg  = calloc(mmax(N,1),1);
+	u8*  cone = calloc(mmax(N,1),1);
+	u32* q    = malloc(Bsize(u32)*mmax(N,1));
+	mfor(j,0,N){
+		chg[j] = old->N<=j || nir->F[j]!=old->F[j] || nir_idim(nir,j)!=nir_idim(old,j) || memcmp(nir->Iidx+nir->Ioff[j], old->Iidx+old->Ioff[j], Bsize(u32)*nir_idim(nir,j))!=0;
+		if(chg[j]){  cone[j]=1;  q[qn++]=j;  ++C;  }
+	}
+	mfor(h,0,qn){  // @q grows while we walk it
+		u32 j=q[h];
+		for(u64 o=nir->Ooff[j]; o<nir->Ooff[j+1]; ++o){
+			u32 k=nir->Oidx[o];
+			if(!cone[k]){  cone[k]=1;  q[qn++]=k;  }
+		}
+	}
+	free(q);
+	*odif = (nirdif_t){C:C, K:qn, chg:chg, cone:cone};
+	nnlogf("\x1b[92mnirdif_ini  \x1b[0mN \x1b[34m%'ld \x1b[0m(parent \x1b[34m%'ld\x1b[0m)  changed \x1b[34m%'ld  \x1b[0mcone \x1b[34m%'ld\x1b[0m\n", N,old->N, C,qn);
+}
+
+// @meta  the levels of @nir, given the levels @olvl of its parent and the cone @dif: Kahn's algorithm (see @nirlvl_ini) over the cone alone, since the in -neurons out of the cone have their old level. on a cycle, it falls back to @nirlvl_ini, which shows it
+fdef void nirdif_lvl(nir_t* nir, nirdif_t* dif, u32* olvl, nirlvl_t* lvl){
+	i64  N=nir->N, L=0, qn=0;
+	u32* lv  = vini1(u32,N+1);  vidim(lv)=N;
+	u32* deg = malloc(Bsize(u32)*mmax(N,1));  // in -neurons of the cone still pending
+	u32* q   = malloc(Bsize(u32)*mmax(N,1));
+	mfor(j,0,N){
+		if(!dif->cone[j]){  lv[j]=olvl[j];  L=mmax(L,lv[j]+1);  continue;  }
+		lv[j]=0;  deg[j]=0;
+		for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e)  deg[j] += dif->cone[nir->Iidx[e]];
+		if(deg[j]==0)  q[qn++]=j;
+	}
+	mfor(h,0,qn){
+		u32 j=q[h];
+		for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e)  lv[j] = mmax(lv[j], lv[nir->Iidx[e]]+1);
+		L = mmax(L,lv[j]+1);
+		for(u64 o=nir->Ooff[j]; o<nir->Ooff[j+1]; ++o){
+			u32 k=nir->Oidx[o];
+			if(dif->cone[k] && --deg[k]==0)  q[qn++]=k;
+		}
+	}
+	free(q);
+	free(deg);
+	if(qn<dif->K){  vend(lv);  nirlvl_ini(nir,lvl);  return;  }
+	nirlvl_idx(N, lv,L, lvl);
+}
+
+// @meta  cut the schedule of @lvl into parts of at most @emax edges of straight-line code (1 neuron, at least): part p is lvl->idx[pj[p] .. pj[p+1]). the inputs (level 0) are in no part, since fwd() copies them. @ret the vec pj
+fdef u64* nirdif_cut(nir_t* nir, nirlvl_t* lvl, i64 emax){
+	u64* pj  = vini(u64);
+	u64  p0  = lvl->off[mmin(lvl->L,1)];
+	i64  acc = 0;
+	vpush(pj,p0);
+	for(u64 p=p0; p<(u64)nir->N; ++p){
+		i64 c = 1+nir_idim(nir,lvl->idx[p]);
+		if(0<acc && emax<acc+c){  vpush(pj,p);  acc=0;  }
+		acc += c;
+	}
+	if(p0<(u64)nir->N)  vpush(pj,(u64)nir->N);
+	return pj;
+}
+
+// @meta  which parts of the child (cut at @pj, w/ levels @lvl) have the same code as the part w/ the same index of the parent @old (w/ levels @olvl): the same neurons, at the same levels, and none changed. @ret a vec of 1 flag per TU (TU t is part t-1, and TU 0 is never reused)
+fdef u8* nirdif_reuse(nir_t* old, nirlvl_t* olvl, nirlvl_t* lvl, nirdif_t* dif, u64* pj){
+	u64* opj = nirdif_cut(old,olvl, NCC_DIF_EMAX);
+	i64  P=vidim(pj)-1, oP=vidim(opj)-1;
+	u8*  re  = vini1(u8,P+1);  vidim(re)=P+1;  memset(re,0x00,P+1);
+	mfor(p,0,mmin(P,oP)){
+		int same = pj[p+1]-pj[p] == opj[p+1]-opj[p];
+		for(u64 q=0; same && q<pj[p+1]-pj[p]; ++q){
+			u32 j = lvl->idx[pj[p]+q];
+			same  = j==olvl->idx[opj[p]+q] && lvl->lvl[j]==olvl->lvl[j] && !dif->chg[j];
+		}
+		re[p+1] = same;
+	}
+	vend(opj);
+	return re;
+}
+
+// @meta  save the levels of @lvl to the net.lvl @path, after the head @h
+fdef void nirdif_save(char* path, nirdifh_t h, nirlvl_t* lvl){
+	u64 bdim = sizeof(h) + Bsize(u32)*h.N;
+	u8* data = malloc(bdim);
+	memcpy(data,&h,sizeof(h));
+	memcpy(data+sizeof(h), lvl->lvl, Bsize(u32)*h.N);
+	file_save(path, data,bdim);
+	free(data);
+}
+
+// @meta  load the net.lvl @path: its head, to @oh, and its levels. @ret a vec of N levels
+fdef u32* nirdif_load(char* path, nirdifh_t* oh){
+	file_t file = file_ini(path);  nnchk(file.path==NULL, "can't open \x1b[92m%s\x1b[0m: is its dir an entry of \x1b[35m-d\x1b[0m?", path);
+	nnchk(file.bdim<sizeof(nirdifh_t), "\x1b[92m%s \x1b[0mis truncated", path);
+	memcpy(oh, file.data, sizeof(nirdifh_t));
+	nnchk(file.bdim!=sizeof(nirdifh_t)+Bsize(u32)*oh->N, "\x1b[92m%s \x1b[0mis truncated", path);
+	u32* lv = vini1(u32,oh->N+1);  vidim(lv)=oh->N;
+	memcpy(lv, file.data+sizeof(nirdifh_t), Bsize(u32)*oh->N);
+	file_end(&file);
+	return lv;
+}
+
+// @meta  the number of levels in the vec of levels @lv
+fdefi i64 nirdif_L(u32* lv){
+	i64 L=0;  mfor(j,0,vidim(lv))  L=mmax(L,lv[j]+1);
+	return L;
+}
+
+// @meta  emit the fwd-pass of @nir in the layout of -d: the header <stem>.h, TU 0 (@path), and TU t (<stem>.t.c) for part t-1 of the cut @pj, unless @re (if not NULL) says the parent has it already. w/ the same x/y/w layout as @nirgen
+fdef void nirdif_gen(char* path, char* srcpath, nir_t* nir, nirlvl_t* lvl, i64 batch, int rt, u64* pj, u8* re){
+	i64   N=nir->N, E=nir->E, NX=0, NY=0, P=vidim(pj)-1;
+	mfor(j,0,N){
+		nnchk(0x06<nir->F[j], "unknown activation fn code \x1b[35m%02x \x1b[0mfor neuron n\x1b[32m%02lx\x1b[0m", nir->F[j],j);
+		if(     nir_idim(nir,j)==0) ++NX;
+		else if(nir_odim(nir,j)==0) ++NY;
+	}
+	int   bat   = 1<batch;
+	char* hpath = nirtu_path(path,-1,".h");
+	char* hname = strrchr(hpath,'/')!=NULL ? strrchr(hpath,'/')+1 : hpath;
+	char* wsig  = bat ? "const float* restrict w" : "const float* w";  // the parts don't need x
+	u32*  a     = malloc(Bsize(u32)*mmax(N,1));  mfor(j,0,N)  a[j]=j;  // the arena is the identity (see @nirgen_vec)
+
+	// ----------------------------------------------------------------  the header: a fn of the options alone
+	FILE* fh = fopen(hpath,"w");  nnchk(fh==NULL, "can't open \x1b[92m%s\x1b[0m: %s", hpath,strerror(errno));
+	fprintf(fh, "// generated by ncc -d. DO NOT EDIT\n");
+	fprintf(fh, "// the header of every TU of a net built w/ ncc -d. it's the same for every net (given the options), so a TU that holds the same neurons as before compiles to the same object\n");
+	if(rt)  fprintf(fh, "#include \"%s\"\n", NCC_RT);
+	else    fprintf(fh, "#include <math.h>\n");
+	fprintf(fh, "\n#if !defined(NCC_SWISH_BETA)\n#define NCC_SWISH_BETA  1.0f\n#endif\n");
+	if(bat)  fprintf(fh, "#define NCC_BATCH  %ld\n", batch);
+	fprintf(fh, "\n#pragma GCC visibility push(hidden)\n");
+	if(bat)  fprintf(fh, "extern float n[][NCC_BATCH];  // n[j][b] is neuron nj of sample b\n");
+	else     fprintf(fh, "extern float n[];  // n[j] is neuron nj\n");
+	fprintf(fh, "extern const unsigned long ncc_wo[];  // the weights of neuron nj are w[ncc_wo[j] .. ncc_wo[j+1])\n");
+	fprintf(fh, "#pragma GCC visibility pop\n\n");
+	if(!rt)  nccrt_act(fh);
+	static const char* fnames[] = {"identity","sigmoid","tanh","relu","silu","gelu","swish"};
+	mfor(f,0,7){
+		if(     f==0)  fprintf(fh, "static inline float ncc_f0(float x){  return x;                                 }  // identity\n");
+		else if(f==3)  fprintf(fh, "static inline float ncc_f3(float x){  return x<0.0f ? 0.0f : x;                 }  // relu\n");
+		else           fprintf(fh, "static inline float ncc_f%ld(float x){  return f32_act1(%ld,NCC_SWISH_BETA,x);  }  // %s\n", f,f,fnames[f]);
+	}
+	fprintf(fh, "\n// the weights are at run-time offsets, which sends gcc's SLP vectorizer into a search that's many times the rest of -O2, for no gain\n");
+	fprintf(fh, "#if defined(__GNUC__) && !defined(__clang__)\n#pragma GCC optimize(\"no-tree-slp-vectorize\")\n#endif\n");
+	nnchk(fclose(fh)!=0, "can't write \x1b[92m%s\x1b[0m: %s", hpath,strerror(errno));
+
+	// ----------------------------------------------------------------  TU 0: the state, and fwd()
+	FILE* fp = fopen(path,"w");  nnchk(fp==NULL, "can't open \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+	setvbuf(fp, NULL,_IOFBF, 0x100000);
+	fprintf(fp, "// generated by ncc -d from %s. DO NOT EDIT\n", srcpath);
+	fprintf(fp, "// N %ld neurons, E %ld edges, NX %ld inputs, NY %ld outputs, L %ld levels, %ld parts of %d edges at most, in TUs 1 .. %ld\n", N,E,NX,NY,lvl->L, P,NCC_DIF_EMAX, P);
+	fprintf(fp, "// x[k] is the k-th input  neuron (no in -indices), in neuron order\n");
+	fprintf(fp, "// y[k] is the k-th output neuron (no out-indices), in neuron order\n");
+	fprintf(fp, "// w[e] is the e-th edge, in edge order: neurons nj in ascending order, and, for each nj, the in-indices Ij in NAL order\n");
+	if(bat)  fprintf(fp, "// batched: fwd() runs NCC_BATCH samples. x[k*NCC_BATCH+b] is the k-th input of sample b, y[k*NCC_BATCH+b] the k-th output\n");
+	if(rt)   fprintf(fp, "#include \"%s\"  // 1st, so it can be precompiled\n", NCC_RT);
+	fprintf(fp, "#include \"%s\"\n\n", hname);
+	fprintf(fp, "#define NCC_N   %ld\n#define NCC_E   %ld\n#define NCC_W   %ld\n#define NCC_NX  %ld\n#define NCC_NY  %ld\n#define NCC_L   %ld\n\n", N,E,E,NX,NY,lvl->L);
+	if(bat)  fprintf(fp, "float n[NCC_N][NCC_BATCH] __attribute__((aligned(64)));\n");
+	else     fprintf(fp, "float n[NCC_N];\n");
+	fprintf(fp, "const unsigned long ncc_wo[NCC_N+1] = {");
+	mfor(j,0,N+1)  fprintf(fp, "%s%lu,", j%32 ? "" : "\n\t", nir->Ioff[j]);
+	fprintf(fp, "\n};\n\n");
+	mfor(p,0,P)  fprintf(fp, "__attribute__((visibility(\"hidden\"))) void ncc_fwd%ld(%s);\n", p+1,wsig);
+	fprintf(fp, "\n");
+	nirgen_fwd_head(fp, bat, 0);
+	i64 k=0;
+	mfor(j,0,N)
+		if(nir_idim(nir,j)==0){
+			if(bat)  fprintf(fp, "\tfor(int b=0; b<NCC_BATCH; ++b)  n[%ld][b] = x[%ld*NCC_BATCH+b];\n", j,k++);
+			else     fprintf(fp, "\tn[%ld] = x[%ld];\n", j,k++);
+		}
+	mfor(p,0,P)  fprintf(fp, "\tncc_fwd%ld(w);\n", p+1);
+	k=0;
+	mfor(j,0,N)
+		if(nir_idim(nir,j)!=0 && nir_odim(nir,j)==0){
+			if(bat)  fprintf(fp, "\tfor(int b=0; b<NCC_BATCH; ++b)  y[%ld*NCC_BATCH+b] = n[%ld][b];\n", k++,j);
+			else     fprintf(fp, "\ty[%ld] = n[%ld];\n", k++,j);
+		}
+	fprintf(fp, "}\n");
+	nnchk(fclose(fp)!=0, "can't write \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+
+	// ----------------------------------------------------------------  the parts: the code of a neuron is the same as in @nirgen, over the identity arena, w/ its weights at ncc_wo[j]
+	u32* js[7];  mfor(f,0,7)  js[f]=vini(u32);  // the neurons of a level w/ a vector activation fn, per activation fn
+	i64  R=0;
+	mfor(p,0,P){
+		if(re!=NULL && re[p+1]){  ++R;  continue;  }
+		char* tpath = nirtu_path(path,p+1,".c");
+		FILE* fq    = fopen(tpath,"w");  nnchk(fq==NULL, "can't open \x1b[92m%s\x1b[0m: %s", tpath,strerror(errno));
+		setvbuf(fq, NULL,_IOFBF, 0x100000);
+		fprintf(fq, "// generated by ncc -d. DO NOT EDIT\n// TU %ld: part %ld of fwd()\n", p+1,p+1);
+		if(rt)  fprintf(fq, "#include \"%s\"  // 1st, so it can be precompiled\n", NCC_RT);
+		fprintf(fq, "#include \"%s\"\n\n", hname);
+		fprintf(fq, "__attribute__((visibility(\"hidden\"))) void ncc_fwd%ld(%s){\n", p+1,wsig);
+		for(u64 q=pj[p]; q<pj[p+1]; ++q){
+			u32 j=lvl->idx[q], l=lvl->lvl[j];
+			if(q==pj[p] || lvl->lvl[lvl->idx[q-1]]!=l)  fprintf(fq, "\t// level %u\n", l);
+			if(bat){
+				if(nir_fvec(nir->F[j]))  fprintf(fq, "\tfor(int b=0; b<NCC_BATCH; ++b)  n[%u][b] =", j);
+				else                     fprintf(fq, "\tfor(int b=0; b<NCC_BATCH; ++b)  n[%u][b] = ncc_f%u(", j,nir->F[j]);
+				for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){  fprintf(fq, " +n[%u][b]*", nir->Iidx[e]);  nirgen_w(fq, NULL, j,e-nir->Ioff[j]);  }
+				if(nir_fvec(nir->F[j]))  fprintf(fq, ";\n\tf32_act(%u,NCC_SWISH_BETA, NCC_BATCH,n[%u],n[%u]);\n", nir->F[j], j,j);  // after the loop, so on a line of its own
+				else                     fprintf(fq, ");\n");
+			}else if(nir_fvec(nir->F[j])){
+				vpush(js[nir->F[j]], j);  // at the end of the level (or the part), w/ the other neurons of its activation fn
+			}else{
+				fprintf(fq, "\tn[%u] = ncc_f%u(", j,nir->F[j]);
+				for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){  fprintf(fq, " +n[%u]*", nir->Iidx[e]);  nirgen_w(fq, NULL, j,e-nir->Ioff[j]);  }
+				fprintf(fq, ");\n");
+			}
+			if(q+1==pj[p+1] || lvl->lvl[lvl->idx[q+1]]!=l)
+				mfor(f,0,7){
+					if(0<vidim(js[f]))  nirgen_vec(fq, nir,a,NULL, 0, f,js[f]);
+					vkeepn(js[f],0);
+				}
+		}
+		fprintf(fq, "}\n");
+		nnchk(fclose(fq)!=0, "can't write \x1b[92m%s\x1b[0m: %s", tpath,strerror(errno));
+		free(tpath);
+	}
+	mfor(f,0,7)  vend(js[f]);
+	free(a);
+	free(hpath);
+	nnlogf("\x1b[92mnirdif_gen  \x1b[0mN \x1b[34m%'ld  \x1b[0mE \x1b[34m%'ld  \x1b[0mL \x1b[34m%'ld  \x1b[0mparts \x1b[34m%'ld \x1b[0m(\x1b[34m%'ld \x1b[0mreused)  \x1b[92m%s\x1b[0m\n", N,E,lvl->L, P,R, path);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nirjit: the fwd-pass as x86-64 machine code, assembled in-process
+/*
+for loops that build and run many nets (eg. an architecture search), where emitting C and running a C compiler costs seconds per net. nirjit_ini() assembles the fwd-pass straight into an mmap'd buffer, in microseconds for small nets, and jit.fwd is `void fwd(const float* x, float* y, const float* w)`, w/ the x/y/w layout of @nirgen (w/o -s)
+the code is the per-neuron code of @nirgen, level by level, over the same activation arena (see @nirmem_ini): every edge is a scalar load of its in-neuron and 1 FMA w/ its weight (a mul and an add w/o FMA), and the sum is in xmm0. identity and relu are inline. the other activation fns go, like in @nirgen_vec, through a scratch array after the arena: the neurons of a level store their sums there, and 1 call to f32_act() (see @fp_src_act) per activation fn and level, 256 at most, writes them back
+registers (SysV): rbx is the arena, r13 x, r14 w, r15 y, all callee-saved, so they survive f32_act(). every displacement is 32-bit, so the arena, x, y and w are at most 2 GB each
+the buffer is mapped RW while it's written and RX after, never both. 1 jit.fwd isn't reentrant (1 arena per nirjit_t), like the fwd() of the C
+*/
+#define NIRJIT_T  0x100  // scratch slots per activation fn
+
+tdef{
+	u8*   code;   // the machine code, mmap'd RX
+	i64   bdim;   // its size, in bytes
+	f32*  n;      // the arena, then the scratch: 7 runs of NIRJIT_T slots, 1 per activation fn
+	i64   A;      // arena size, in neurons
+	int   fma;    // 1 if the code uses FMA
+	void (*fwd)(const float* x, float* y, const float* w);
+}nirjit_t;
+
+fdef void nirjit_end(nirjit_t* jit){
+	if(jit==NULL) return;
+	if(jit->code!=NULL) munmap(jit->code,jit->bdim);
+	free(jit->n);
+	*jit=(nirjit_t){0x00};
+}
+
+fdefi void nirjit_put(u8** c, i64 k, const u8* b){  memcpy(*c,b,k);  *c+=k;  }
+fdefi void nirjit_d32(u8** c, u32 d){  memcpy(*c,&d,4);  *c+=4;  }  // x86 is little-endian
+fdefi void nirjit_d64(u8** c, u64 d){  nirjit_d32(c,d);  nirjit_d32(c,d>>32);  }
+
+// @meta  `pfx 0f op xmm@r, [@base + @d]`, for SSE scalar ops (movss load 10, store 11, mulss 59) w/ a 32-bit displacement. @base is a GPR code: 3 rbx, 13 r13, 14 r14, 15 r15
+fdefi void nirjit_mem(u8** c, u8 pfx, u8 op, u8 r, u8 base, u32 d){
+	u8 b[6]={pfx, 0x41, 0x0f, op, 0x80|r<<3|(base&7)};
+	if(base<8){  b[1]=0x0f;  b[2]=op;  b[3]=b[4];  nirjit_put(c,4,b);  }
+	else       nirjit_put(c,5,b);
+	nirjit_d32(c,d);
+}
+
+// @meta  xmm0 = SUM[i,Ij, n[a[i]]*w[woff[j]+..]] of neuron nj
+fdef void nirjit_dot(u8** c, nir_t* nir, u32* a, u64* woff, int fma, u32 j){
+	static const u8 xor0[] = {0x0f,0x57,0xc0};                   // xorps xmm0,xmm0
+	static const u8 add01[]= {0xf3,0x0f,0x58,0xc1};              // addss xmm0,xmm1
+	static const u8 vfma[] = {0xc4,0xc2,0x71,0xb9,0x86};         // vfmadd231ss xmm0,xmm1,[r14+d32]
+	nirjit_put(c,sizeof(xor0),xor0);
+	for(u64 e=nir->Ioff[j]; e<nir->Ioff[j+1]; ++e){
+		u32 wd = 4*(woff[j]+(e-nir->Ioff[j]));
+		nirjit_mem(c, 0xf3,0x10, 1, 3, 4*a[nir->Iidx[e]]);  // movss xmm1,[rbx + 4*a[i]]
+		if(fma){  nirjit_put(c,sizeof(vfma),vfma);  nirjit_d32(c,wd);  }
+		else{     nirjit_mem(c, 0xf3,0x59, 1, 14, wd);  nirjit_put(c,sizeof(add01),add01);  }  // mulss xmm1,[r14 + 4*e]
+	}
+}
+
+// @meta  the scratch run of activation fn @f holds the sums of the neurons @js: 1 call to f32_act(f,beta,k,t,t), then copy t back to their slots
+fdef void nirjit_act(u8** c, u32* a, i64 A, f32 beta, u32 f, u32* js){
+	i64 k = vidim(js);
+	u32 t = 4*(A + f*NIRJIT_T);
+	u32 bb;  memcpy(&bb,&beta,4);
+	u8  b0[]={0xbf}, b1[]={0xb8}, b2[]={0x66,0x0f,0x6e,0xc0}, b3[]={0xbe}, b4[]={0x48,0x8d,0x93}, b5[]={0x48,0x8d,0x8b}, b6[]={0x48,0xb8}, b7[]={0xff,0xd0};
+	nirjit_put(c,1,b0);  nirjit_d32(c,f);                          // mov edi,f
+	nirjit_put(c,1,b1);  nirjit_d32(c,bb);                         // mov eax,beta
+	nirjit_put(c,4,b2);                                            // movd xmm0,eax
+	nirjit_put(c,1,b3);  nirjit_d32(c,k);                          // mov esi,k
+	nirjit_put(c,3,b4);  nirjit_d32(c,t);                          // lea rdx,[rbx + t]
+	nirjit_put(c,3,b5);  nirjit_d32(c,t);                          // lea rcx,[rbx + t]
+	nirjit_put(c,2,b6);  nirjit_d64(c,(u64)(uintptr_t)&f32_act);  // mov rax,f32_act
+	nirjit_put(c,2,b7);                                            // call rax
+	mfor(q,0,k){
+		nirjit_mem(c, 0xf3,0x10, 0, 3, t+4*q);       // movss xmm0,[rbx + t+4*q]
+		nirjit_mem(c, 0xf3,0x11, 0, 3, 4*a[js[q]]);  // movss [rbx + 4*a[j]],xmm0
+	}
+	vkeepn(js,0);
+}
+
+// @meta  O[V+E] assemble the fwd-pass of @nir into @ojit (caller must nirjit_end() it). @beta is the swish beta, ie. the NCC_SWISH_BETA of the C
+fdef void nirjit_ini(nir_t* nir, nirlvl_t* lvl, f32 beta, nirjit_t* ojit){
+#if !defined(__x86_64__)
+	nnchk(1, "the JIT only emits x86-64");
+#endif
+	i64 N=nir->N;
+	mfor(j,0,N)  nnchk(0x06<nir->F[j], "unknown activation fn code \x1b[35m%02x \x1b[0mfor neuron n\x1b[32m%02lx\x1b[0m", nir->F[j],j);
+	nirconv_t* cvs  = vini(nirconv_t);
+	nirblk_t*  blks = vini(nirblk_t);
+	nirmem_t   mem;  nirmem_ini(nir,lvl, cvs, blks,NULL, 0, &mem);
+	u32*       a    = mem.a;
+	u64*       woff = malloc(Bsize(u64)*(N+1));  woff[0]=0;  mfor(j,0,N)  woff[j+1] = woff[j]+nir_idim(nir,j);
+	nnchk(0x1fffffff<=mem.A+7*NIRJIT_T || 0x1fffffff<=woff[N] || 0x1fffffff<=N, "the JIT addresses the arena, x, y and w w/ 32-bit displacements, but there are \x1b[34m%'ld \x1b[0mslots and \x1b[34m%'lu \x1b[0mweights", mem.A,woff[N]);
+	int fma = 0;
+#if defined(__GNUC__) && !defined(__TINYC__)
+	fma = __builtin_cpu_supports("fma")!=0;
+#endif
+
+	static const u8 pro[] = {0x55, 0x48,0x89,0xe5, 0x53, 0x41,0x55, 0x41,0x56, 0x41,0x57, 0x49,0x89,0xfd, 0x49,0x89,0xf7, 0x49,0x89,0xd6};  // push rbp; mov rbp,rsp; push rbx,r13,r14,r15; mov r13,rdi; mov r15,rsi; mov r14,rdx
+	static const u8 epi[] = {0x41,0x5f, 0x41,0x5e, 0x41,0x5d, 0x5b, 0x5d, 0xc3};  // pop r15,r14,r13,rbx,rbp; ret
+	static const u8 relu[]= {0x0f,0x57,0xc9, 0xf3,0x0f,0x5f,0xc8, 0x0f,0x28,0xc1};  // xorps xmm1,xmm1; maxss xmm1,xmm0; movaps xmm0,xmm1. so -0 and NaN pass, like x<0 ? 0 : x
+	static const u8 movrbx[] = {0x48,0xbb};  // mov rbx,imm64
+	i64  bdim = divceilu64(64 + 98*N + 21*nir->E, 0x1000)*0x1000;  // bytes, at most: 18 per neuron for the x/y moves, 80 for its store (and its share of an f32_act() call), and 21 per edge
+	u8*  code = mmap(NULL,bdim, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1,0);
+	nnchk(code==MAP_FAILED, "can't map \x1b[34m%'ld \x1b[0mbytes of code: %s", bdim,strerror(errno));
+	f32* n = aligned_alloc(64, Bsize(f32)*divceilu64(mem.A+7*NIRJIT_T,16)*16);
+	u8*  c = code;  // the cursor
+	u32* js[7];  mfor(f,0,7)  js[f]=vini(u32);
+	nirjit_put(&c,sizeof(pro),pro);
+	nirjit_put(&c,sizeof(movrbx),movrbx);  nirjit_d64(&c,(u64)(uintptr_t)n);
+	i64 k=0;
+	mfor(l,0,lvl->L){  // level 0 holds exactly the input neurons, in ascending order
+		for(u64 p=lvl->off[l]; p<lvl->off[l+1]; ++p){
+			u32 j=lvl->idx[p], f=nir->F[j];
+			if(nir_idim(nir,j)==0){
+				nirjit_mem(&c, 0xf3,0x10, 0, 13, 4*k++);  // movss xmm0,[r13 + 4*k]
+				nirjit_mem(&c, 0xf3,0x11, 0, 3, 4*a[j]);  // movss [rbx + 4*a[j]],xmm0
+				continue;
+			}
+			nirjit_dot(&c, nir,a,woff, fma, j);
+			if(nir_fvec(f)){  // the neurons of a level don't read each other, and don't share slots, so their writes can wait
+				nirjit_mem(&c, 0xf3,0x11, 0, 3, 4*(mem.A + f*NIRJIT_T + vidim(js[f])));  // movss [rbx + t],xmm0
+				vpush(js[f], j);
+				if(vidim(js[f])==NIRJIT_T)  nirjit_act(&c, a,mem.A, beta, f,js[f]);
+				continue;
+			}
+			if(f==0x03)  nirjit_put(&c,sizeof(relu),relu);
+			nirjit_mem(&c, 0xf3,0x11, 0, 3, 4*a[j]);  // movss [rbx + 4*a[j]],xmm0
+		}
+		mfor(f,0,7)  if(0<vidim(js[f]))  nirjit_act(&c, a,mem.A, beta, f,js[f]);
+	}
+	k=0;
+	mfor(j,0,N)
+		if(nir_idim(nir,j)!=0 && nir_odim(nir,j)==0){
+			nirjit_mem(&c, 0xf3,0x10, 0, 3, 4*a[j]);    // movss xmm0,[rbx + 4*a[j]]
+			nirjit_mem(&c, 0xf3,0x11, 0, 15, 4*k++);    // movss [r15 + 4*k],xmm0
+		}
+	nirjit_put(&c,sizeof(epi),epi);
+
+	nnchk(code+bdim<c, "the JIT overran its buffer: \x1b[34m%'ld \x1b[0mbytes of \x1b[34m%'ld\x1b[0m", c-code,bdim);
+	nnchk(mprotect(code,bdim, PROT_READ|PROT_EXEC)!=0, "can't make the code executable: %s", strerror(errno));
+	*ojit = (nirjit_t){code:code, bdim:bdim, n:n, A:mem.A, fma:fma};
+	ojit->fwd = (void (*)(const float*,float*,const float*))code;
+	nnlogf("\x1b[92mnirjit  \x1b[0mN \x1b[34m%'ld  \x1b[0mE \x1b[34m%'ld  \x1b[0mA \x1b[34m%'ld  \x1b[0mcode \x1b[34m%'ld \x1b[0mB  fma \x1b[34m%d\x1b[0m\n", N,nir->E,mem.A,c-code,fma);
+	mfor(f,0,7)  vend(js[f]);
+	free(woff);
+	nirmem_end(&mem);
+	vend(blks);
+	vend(cvs);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1  nccache: compiled models, content-addressed
+/*
+-K dir keeps every model it compiles in dir/<key>/: net.c (the emitted C), net.csr (its CSR blob, if any), net.so (the C compiled as a shared object) and net.nab (the graph). a 2nd compile of the same input w/ the same options is a hit, which skips parsing, levelization, codegen and the C compiler, and goes straight to dlopen()
+the key is 128 bits of xxh64 (2 seeds) over the input bytes and a string of everything else the output depends on: the input format, the codegen options, the ncc build (which fixes what the activation codes mean, and the codegen), and the C compiler and its flags (see @nccache_id). the graph, activation codes included, is a pure fn of the input bytes, so it's hashed before it's parsed: that's what makes a hit O[input bytes] and not O[parse]. the same graph in 2 formats (eg. a .nal and its .nab) is 2 entries, which only costs a miss
+the C of an entry #include's the runtime headers (see @blk1 nccrt) from dir/rt<key>, where they're precompiled. they're keyed by the ncc build and the C compiler alone (see @nccache_id), so all the entries of 1 ncc build share them, and a miss only compiles the code of its model
+an entry is complete once net.so exists: it's compiled to a temp name and then rename()'d, and it's written last. a miss takes an flock() on dir/<key>/lock before it writes anything, so 2 concurrent compiles of 1 model build it once (the 2nd one waits, and then hits), and a crashed build leaves no lock behind
+-march=native makes an entry specific to the CPU, so a cache dir is specific to the machine (or the CPU model) that fills it
+*/
+#include <dlfcn.h>     // @dlopen()
+#include <sys/file.h>  // @flock()
+
+#define NCC_CACHE_CC  "/usr/bin/cc"  // the C compiler of -K, unless $NCC_CC names another. it's execv()'d, so it's a full path, not a name to look up in $PATH
+
+tdef{
+	u64   key[2];
+	char* dir;      // dir/<key>
+	char* rtdir;    // dir/rt<key>: the runtime headers, precompiled (see @blk1 nccrt)
+	char* cpath;    // dir/<key>/net.c
+	char* csrpath;  // dir/<key>/net.csr
+	char* sopath;   // dir/<key>/net.so
+	char* nabpath;  // dir/<key>/net.nab
+	int   lock;     // the fd of dir/<key>/lock, while a miss builds the entry, or -1
+	void* so;       // the dlopen() handle of net.so
+	void (*fwd)(const float* x, float* y, const float* w);
+}nccache_t;
+
+// @meta  the C compiler of -K
+fdef char* nccache_ccname(){  return getenv("NCC_CC")!=NULL ? getenv("NCC_CC") : NCC_CACHE_CC;  }
+
+// @meta  the identity of the ncc build and of the C compiler @cc, for the keys: xxh64 of the ncc binary (/proc/self/exe), so a rebuild of the same source w/ the same compiler keeps the cache, and any change to the codegen drops it, and the size and mtime of the compiler binary (symlinks followed), so an upgrade of the compiler drops it too. it's O[size of ncc], not a cc --version, which would be a fork+exec per hit
+fdef void nccache_id(char* cc, char* oid, i64 bdim){
+	static u64 exe = 0;
+	if(exe==0){
+		file_t file = file_ini("/proc/self/exe");  nnchk(file.path==NULL, "can't read \x1b[92m/proc/self/exe\x1b[0m, to key the cache on the ncc build");
+		exe = xxh64(file.data,file.bdim,0);
+		file_end(&file);
+	}
+	struct stat st;  nnchk(stat(cc,&st)<0, "can't stat the C compiler \x1b[92m%s\x1b[0m: %s", cc,strerror(errno));
+	snprintf(oid,bdim, "ncc %016lx  cc %s %ld %ld", exe, cc,(i64)st.st_size,(i64)(st.st_mtim.tv_sec*1000000000ll+st.st_mtim.tv_nsec));
+}
+
+fdef char* nccache_path(char* dir, char* name){
+	char* path = malloc(strlen(dir)+1+strlen(name)+1);
+	sprintf(path, "%s/%s", dir,name);
+	return path;
+}
+
+// @meta  the entry of @filepath (w/ codegen options @opts) in cache dir @dir. it creates @dir and the entry's dir, if they don't exist
+fdef void nccache_ini(char* dir, char* filepath, char* opts, nccache_t* ocache){
+	file_t file = file_ini(filepath);
+	u64    h0=xxh64(opts,strlen(opts),0), h1=xxh64(opts,strlen(opts),XXH_P5);
+	u64    key[2] = {xxh64(file.data,file.bdim,h0), xxh64(file.data,file.bdim,h1)};
+	file_end(&file);
+	nnchk(mkdir(dir,0755)<0 && errno!=EEXIST, "can't make the cache dir \x1b[92m%s\x1b[0m: %s", dir,strerror(errno));
+	char name[33];  sprintf(name, "%016lx%016lx", key[0],key[1]);
+	*ocache = (nccache_t){key:{key[0],key[1]}, dir:nccache_path(dir,name), lock:-1};
+	nnchk(mkdir(ocache->dir,0755)<0 && errno!=EEXIST, "can't make the cache entry \x1b[92m%s\x1b[0m: %s", ocache->dir,strerror(errno));
+	char id[0x1000];      nccache_id(nccache_ccname(), id,sizeof(id));
+	char rtopts[0x1100];  snprintf(rtopts,sizeof(rtopts), "%s -O2 -march=native -fPIC", id);
+	char rtname[32];      sprintf(rtname, "rt%016lx", xxh64(rtopts,strlen(rtopts),0));
+	ocache->rtdir = nccache_path(dir,rtname);
+	ocache->cpath   = nccache_path(ocache->dir,"net.c");
+	ocache->csrpath = nccache_path(ocache->dir,"net.csr");
+	ocache->sopath  = nccache_path(ocache->dir,"net.so");
+	ocache->nabpath = nccache_path(ocache->dir,"net.nab");
+	nnlogf("\x1b[92mnccache_ini  \x1b[0mopts \x1b[33m%s  \x1b[92m%s\x1b[0m\n", opts, ocache->dir);
+}
+
+fdef void nccache_end(nccache_t* cache){
+	if(cache==NULL) return;
+	if(cache->so!=NULL)  dlclose(cache->so);
+	if(cache->lock>=0)   close(cache->lock);  // and the flock() goes w/ it
+	free(cache->nabpath);  free(cache->sopath);  free(cache->csrpath);  free(cache->cpath);  free(cache->rtdir);  free(cache->dir);
+	*cache=(nccache_t){lock:-1};
+}
+
+// @meta  dlopen() net.so, check it has fwd() (and bwd() if @grad), and give its ncc_init() (if it has one, ie. if it has CSR loops) the entry's .csr
+fdef void nccache_load(nccache_t* cache, int grad){
+	cache->so  = dlopen(cache->sopath, RTLD_NOW|RTLD_LOCAL);  nnchk(cache->so==NULL, "can't load \x1b[92m%s\x1b[0m: %s", cache->sopath,dlerror());
+	cache->fwd = (void (*)(const float*,float*,const float*))dlsym(cache->so,"fwd");  nnchk(cache->fwd==NULL, "\x1b[92m%s \x1b[0mhas no fwd()", cache->sopath);
+	nnchk(grad && dlsym(cache->so,"bwd")==NULL, "\x1b[92m%s \x1b[0mhas no bwd()", cache->sopath);
+	int (*init)(const char*) = (int (*)(const char*))dlsym(cache->so,"ncc_init");
+	nnchk(init!=NULL && init(cache->csrpath)!=0, "\x1b[92m%s \x1b[0mdoesn't match \x1b[92m%s\x1b[0m: delete \x1b[92m%s \x1b[0mto rebuild it", cache->csrpath,cache->sopath, cache->dir);
+}
+
+// @meta  1 (and the entry is loaded) on a hit. 0 on a miss, and then the caller holds the entry's lock, and must fill it: net.c, net.csr and net.nab, and then @nccache_put()
+fdef int nccache_get(nccache_t* cache, int grad){
+	if(access(cache->sopath,F_OK)==0){  nccache_load(cache,grad);  return 1;  }
+	char* path  = nccache_path(cache->dir,"lock");
+	cache->lock = open(path, O_RDWR|O_CREAT, 0644);  nnchk(cache->lock<0, "can't open \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+	nnchk(flock(cache->lock,LOCK_EX)<0, "can't lock \x1b[92m%s\x1b[0m: %s", path,strerror(errno));
+	free(path);
+	if(access(cache->sopath,F_OK)==0){  // it was built while we waited for the lock
+		close(cache->lock);  cache->lock=-1;
+		nccache_load(cache,grad);
+		return 1;
+	}
+	return 0;
+}
+
+// @meta  compile the @tus TUs of @cpath (see @blk1 nirtu), w/ the runtime headers in @rtdir, and link them into @sopath. the TUs go to objects (<stem>.o, <stem>.1.o, ..) in parallel, 1 process per core at most, and 1 TU is compiled and linked in 1 go. a TU t w/ keep[t] (if @keep isn't NULL) has its object already (see @nccache_reuse). @ret 1 on success
+fdef int nccache_cc(char* cc, char* rtdir, char* cpath, i64 tus, u8* keep, char* sopath){
+	if(tus<=1){
+		char* args[] = {cc, "-O2","-march=native","-fPIC", "-I",rtdir, "-shared", "-o",sopath, cpath, "-lm", NULL};
+		char** argss[] = {args};
+		return execpool(1,argss, 1)==0;  // exec1() doesn't give the exit status
+	}
+	char**  srcs  = malloc(sizeof(char*)*tus);
+	char**  objs  = malloc(sizeof(char*)*tus);
+	char*** argss = malloc(sizeof(char**)*tus);
+	i64     n     = 0;  // TUs to compile
+	mfor(t,0,tus){
+		srcs[t] = t==0 ? cpath : nirtu_path(cpath,t,".c");
+		objs[t] = nirtu_path(cpath, t==0 ? -1 : t, ".o");
+		if(keep!=NULL && keep[t])  continue;
+		char* args[] = {cc, "-O2","-march=native","-fPIC", "-I",rtdir, "-c","-o",objs[t], srcs[t], NULL};
+		argss[n] = malloc(sizeof(args));  memcpy(argss[n],args,sizeof(args));  ++n;
+	}
+	int ok = execpool(n,argss, sysconf(_SC_NPROCESSORS_ONLN))==0;
+	if(ok){
+		char** link = malloc(sizeof(char*)*(tus+6));
+		link[0]=cc;  link[1]="-shared";  link[2]="-o";  link[3]=sopath;
+		mfor(t,0,tus)  link[4+t]=objs[t];
+		link[4+tus]="-lm";  link[5+tus]=NULL;
+		ok = execpool(1,&link, 1)==0;
+		free(link);
+	}
+	mfor(t,0,n)  free(argss[t]);
+	mfor(t,0,tus){
+		free(objs[t]);
+		if(0<t)  free(srcs[t]);
+	}
+	free(argss);  free(objs);  free(srcs);
+	return ok;
+}
+
+// @meta  make sure the runtime headers of the cache are in its rtdir, precompiled. the 1st miss of an ncc build writes and compiles them, under the lock of rtdir/lock, and the rest wait for it. nccrt_simd.h is renamed into place last, so it marks them done. a compiler that can't precompile them (or doesn't look for a .gch) still has the headers, and parses them
+fdef void nccache_rt(nccache_t* cache, char* cc){
+	char* spath = nccache_path(cache->rtdir, NCC_RT_SIMD);
+	if(access(spath,F_OK)==0){  free(spath);  return;  }
+	nnchk(mkdir(cache->rtdir,0755)<0 && errno!=EEXIST, "can't make the runtime dir \x1b[92m%s\x1b[0m: %s", cache->rtdir,strerror(errno));
+	char* lpath = nccache_path(cache->rtdir,"lock");
+	int   lock  = open(lpath, O_RDWR|O_CREAT, 0644);  nnchk(lock<0, "can't open \x1b[92m%s\x1b[0m: %s", lpath,strerror(errno));
+	nnchk(flock(lock,LOCK_EX)<0, "can't lock \x1b[92m%s\x1b[0m: %s", lpath,strerror(errno));
+	if(access(spath,F_OK)!=0){
+		char sfx[32];  sprintf(sfx, ".%d", getpid());
+		nccrt_put(cache->rtdir, sfx);
+		char *srcs[2], *dsts[2], *gchs[2], **argss[2];
+		mfor(i,0,2){
+			char* name = i==0 ? NCC_RT : NCC_RT_SIMD;
+			dsts[i] = nccache_path(cache->rtdir,name);
+			srcs[i] = malloc(strlen(dsts[i])+32);  sprintf(srcs[i], "%s%s", dsts[i],sfx);
+			gchs[i] = malloc(strlen(dsts[i])+32);  sprintf(gchs[i], "%s.gch", dsts[i]);
+			char* args[] = {cc, "-O2","-march=native","-fPIC", "-x","c-header", "-o",gchs[i], srcs[i], NULL};
+			argss[i] = malloc(sizeof(args));  memcpy(argss[i],args,sizeof(args));
+		}
+		if(execpool(2,argss, sysconf(_SC_NPROCESSORS_ONLN))!=0)  mfor(i,0,2)  unlink(gchs[i]);  // w/o them, it still works, only slower
+		mfor(i,0,2){
+			nnchk(rename(srcs[i],dsts[i])<0, "can't rename \x1b[92m%s \x1b[0mto \x1b[92m%s\x1b[0m: %s", srcs[i],dsts[i],strerror(errno));
+			free(argss[i]);  free(gchs[i]);  free(srcs[i]);  free(dsts[i]);
+		}
+	}
+	close(lock);
+	free(lpath);  free(spath);
+}
+
+// @meta  compile the entry's @tus TUs to net.so (but the ones w/ keep[t], see @nccache_cc), publish it, drop the lock, and load it
+fdef void nccache_put(nccache_t* cache, int grad, i64 tus, u8* keep){
+	char* cc  = nccache_ccname();
+	nccache_rt(cache, cc);
+	char* tmp = malloc(strlen(cache->sopath)+32);  sprintf(tmp, "%s.%d", cache->sopath,getpid());
+	int   ok  = nccache_cc(cc, cache->rtdir, cache->cpath, tus, keep, tmp);
+	if(!ok)  unlink(tmp);
+	nnchk(!ok, "\x1b[92m%s \x1b[0mfailed (its output is silenced): rerun it on \x1b[92m%s\x1b[0m, w/ \x1b[33m-O2 -march=native -fPIC -I%s\x1b[0m", cc, cache->cpath, cache->rtdir);
+	nnchk(rename(tmp,cache->sopath)<0, "can't rename \x1b[92m%s \x1b[0mto \x1b[92m%s\x1b[0m: %s", tmp,cache->sopath,strerror(errno));
+	free(tmp);
+	close(cache->lock);  cache->lock=-1;
+	nccache_load(cache,grad);
+}
+
+// @meta  copy @src to @dst
+fdef void nccache_copy(char* src, char* dst){
+	file_t file = file_ini(src);  nnchk(file.path==NULL, "can't open \x1b[92m%s\x1b[0m", src);
+	file_save(dst, file.data,file.bdim);
+	file_end(&file);
+}
+
+// @meta  give the entry the TUs t w/ keep[t] (the parts that -D reuses, see @blk1 nirdif), and their objects, from the entry @odir: hard links, since entries are never written after their net.so, or copies, if @odir is on another fs
+fdef void nccache_reuse(nccache_t* cache, char* odir, i64 tus, u8* keep){
+	char* ocpath = nccache_path(odir,"net.c");
+	mfor(t,1,tus){
+		if(!keep[t])  continue;
+		mfor(i,0,2){
+			char* src = nirtu_path(ocpath,      t, i==0 ? ".c" : ".o");
+			char* dst = nirtu_path(cache->cpath,t, i==0 ? ".c" : ".o");
+			unlink(dst);  // a crashed build may have left it
+			if(link(src,dst)<0)  nccache_copy(src,dst);
+			free(dst);  free(src);
+		}
+	}
+	free(ocpath);
+}
+
+// @meta  copy the @tus TUs of the C file @src (see @blk1 nirtu) to @dst. the TUs #include their header by name, so the name changes from the one of @src to the one of @dst
+fdef void nccache_copytu(char* src, char* dst, i64 tus){
+	if(tus<=1){  nccache_copy(src,dst);  return;  }
+	char* shpath = nirtu_path(src,-1,".h");
+	char* dhpath = nirtu_path(dst,-1,".h");
+	char* shname = strrchr(shpath,'/')!=NULL ? strrchr(shpath,'/')+1 : shpath;
+	char* dhname = strrchr(dhpath,'/')!=NULL ? strrchr(dhpath,'/')+1 : dhpath;
+	char* sinc   = malloc(strlen(shname)+32);  sprintf(sinc, "#include \"%s\"", shname);  i64 sdim=strlen(sinc);
+	nccache_copy(shpath,dhpath);
+	mfor(t,0,tus){
+		char*  spath = t==0 ? src : nirtu_path(src,t,".c");
+		char*  dpath = t==0 ? dst : nirtu_path(dst,t,".c");
+		file_t file  = file_ini(spath);  nnchk(file.path==NULL, "can't open \x1b[92m%s\x1b[0m", spath);
+		i64    p0=0;  while(p0+sdim<=file.bdim && memcmp(file.data+p0,sinc,sdim)!=0)  ++p0;
+		i64    p1=p0+sdim;
+		nnchk(file.bdim<p1, "\x1b[92m%s \x1b[0mdoesn't #include its header", spath);
+		FILE* fp = fopen(dpath,"w");  nnchk(fp==NULL, "can't open \x1b[92m%s\x1b[0m: %s", dpath,strerror(errno));
+		fwrite(file.data,1,p0, fp);
+		fprintf(fp, "#include \"%s\"", dhname);
+		fwrite(file.data+p1,1,file.bdim-p1, fp);
+		nnchk(fclose(fp)!=0, "can't write \x1b[92m%s\x1b[0m: %s", dpath,strerror(errno));
+		file_end(&file);
+		if(0<t){  free(dpath);  free(spath);  }
+	}
+	free(sinc);  free(dhpath);  free(shpath);
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------# @blk1
+fdefe int main(int nargs, char* args[]){
+	char* filepath = NALPATH;
+	char* cpath    = NULL;  // if not NULL, emit the fwd-pass as C code to this path
+	char* nabpath  = NULL;  // if not NULL, save the graph as a .nab to this path
+	int   verify   = 0;     // checksum a .nab input
+	int   share    = 0;     // conv planes share their weights
+	int   grad     = 0;     // also emit the bwd-pass
+	i64   batch    = 1;     // samples per fwd() call. 0 picks it from the L1 size (see @nirbatch)
+	i64   sellc    = 0;     // lanes of the SELL slices, or 0 for none
+	i64   unroll   = NCC_UNROLL_EMAX;  // edges of straight-line code, at most. the levels past it are CSR loops
+	int   jit      = 0;     // assemble the fwd-pass in-process (see @nirjit_ini), and time it
+	i64   tus      = 1;     // TUs of the generated code (see @blk1 nirtu). 0 is 1 per core
+	int   rt       = 0;     // the generated code #include's the runtime headers, next to it (see @blk1 nccrt). -K implies it
+	char* cachedir = NULL;  // if not NULL, look the model up in this cache dir before parsing it, and put it there after compiling it (see @blk1 nccache)
+	int   dif      = 0;     // emit the C in the diffable layout (see @blk1 nirdif)
+	char* difdir   = NULL;  // if not NULL, the -K entry of the parent, to rebuild the model incrementally from. it implies -d
+	i64   nthreads = sysconf(_SC_NPROCESSORS_ONLN);  // NAL parse threads
+	mfor(i,1,nargs){
+		if(     strcmp(args[i],"-o")==0 && i+1<nargs)  cpath    = args[++i];
+		else if(strcmp(args[i],"-b")==0 && i+1<nargs)  nabpath  = args[++i];
+		else if(strcmp(args[i],"-c")==0)               verify   = 1;
+		else if(strcmp(args[i],"-s")==0)               share    = 1;
+		else if(strcmp(args[i],"-g")==0)               grad     = 1;
+		else if(strcmp(args[i],"-B")==0 && i+1<nargs)  batch    = mmax(0,atol(args[++i]));  // -B auto is -B 0
+		else if(strcmp(args[i],"-C")==0 && i+1<nargs)  sellc    = mmax(0,atol(args[++i]));
+		else if(strcmp(args[i],"-u")==0 && i+1<nargs)  unroll   = mmax(0,atol(args[++i]));
+		else if(strcmp(args[i],"-T")==0 && i+1<nargs)  tus      = mmax(0,atol(args[++i]));  // -T auto is -T 0
+		else if(strcmp(args[i],"-R")==0)               rt       = 1;
+		else if(strcmp(args[i],"-J")==0)               jit      = 1;
+		else if(strcmp(args[i],"-K")==0 && i+1<nargs)  cachedir = args[++i];
+		else if(strcmp(args[i],"-d")==0)               dif      = 1;
+		else if(strcmp(args[i],"-D")==0 && i+1<nargs){  difdir  = args[++i];  dif=1;  }
+		else if(strcmp(args[i],"-j")==0 && i+1<nargs)  nthreads = mmax(1,atol(args[++i]));
+		else if(strcmp(args[i],"-q")==0)               ncc_lvl  = NCC_QUIET;
+		else if(strcmp(args[i],"-v")==0)               ncc_lvl  = NCC_VERBOSE;
+		else                                           filepath = args[i];
+	}
+	if(tus==0)  tus = sysconf(_SC_NPROCESSORS_ONLN);
+	if(cachedir!=NULL)  rt = 1;
+	if(dif)  tus = 1;  // -d cuts its own TUs
+	nnchk(dif && (share || grad || 0<sellc), "\x1b[35m-d \x1b[0memits a fwd-pass of single neurons: it doesn't take \x1b[35m-s\x1b[0m, \x1b[35m-g \x1b[0mor \x1b[35m-C\x1b[0m");
+	nnchk(difdir!=NULL && cachedir==NULL, "\x1b[35m-D \x1b[0mrebuilds from an entry of a cache: it needs \x1b[35m-K\x1b[0m");
+	if(access(filepath,F_OK|R_OK)<0){ fail("can't open \x1b[92m%s\x1b[0m",filepath); exit(1); }
+	setlocale(LC_NUMERIC,"");
+	nnlog = stdout;
+	if(nnverbose())  setvbuf(nnlog, NULL,_IOFBF, 0x100000);
+
+	// ----------------------------------------------------------------
+	dt_t dt_all = dt_ini();
+	nnlogf("filepath \x1b[34m%s\x1b[0m\n", filepath);
+	if(nnverbose())  nntut();
+
+	nir_t    nir;
+	nirlvl_t lvl;
+	dt_t     dt_read,dt_parse,dt_lvl={0},dt_gen={0},dt_jit={0},dt_cache={0},dt_cc={0};
+	f64      tfwd=0;  // ns per call of the JIT's fwd
+	i64    bdim;  // input size (decompressed, for a .zst), for the parse throughput
+	nccache_t cache = {lock:-1};
+	int       hit   = 0;
+	u64       optsh = 0;  // the hash of the cache options, for net.lvl (see @nirdifh_t)
+	if(cachedir!=NULL){  // the key covers everything the entry depends on but the input bytes, which it hashes itself
+		char* ext   = strchr(strrchr(filepath,'/')!=NULL ? strrchr(filepath,'/') : filepath, '.');
+		char* cc    = nccache_ccname();
+		i64   l1    = batch==0 ? sysconf(_SC_LEVEL1_DCACHE_SIZE) : 0;  // -B 0 depends on it
+		char  id[0x1000];    nccache_id(cc, id,sizeof(id));
+		char  opts[0x1100];  snprintf(opts,sizeof(opts), "%s  %s  share %d grad %d batch %ld l1 %ld sellc %ld unroll %ld tus %ld dif %d  -O2 -march=native -fPIC", id, ext!=NULL ? ext : "", share,grad,batch,l1,sellc,unroll,tus,dif);
+		optsh = xxh64(opts,strlen(opts),0);
+		dt_cache = dt_ini();
+		nccache_ini(cachedir, filepath, opts, &cache);
+		hit = nccache_get(&cache, grad);
+		dt_end(&dt_cache);
+	}
+	if(hit){  // the .nab is the graph, w/o a parse: it's only for the summary, -b and -J
+		dt_read = dt_ini();  file_t nabfile = file_ini(cache.nabpath);  dt_end(&dt_read);  bdim=nabfile.bdim;
+		dt_parse = dt_ini();  nabload(nabfile, 0, &nir);  dt_end(&dt_parse);
+	}else if(path_endswith(filepath,".zst")){
+#if defined(M_ZSTD)
+		nnchk(!path_endswith(filepath,".nal.zst") && !path_endswith(filepath,".nam.zst"), "only .nal.zst and .nam.zst inputs are zstd-compressed: \x1b[92m%s\x1b[0m", filepath);
+		dt_read  = (dt_t){0};  // reading is decompressing, and it's interleaved w/ parsing, 1 window at a time, so it's all parse time
+		dt_parse = dt_ini();
+		if(path_endswith(filepath,".nam.zst")){  u32* P=NULL;  namparse_zst(filepath, &nir,&P, &bdim);  free(P);  }
+		else                                     nirparse_zst(filepath, nthreads, &nir, &bdim);
+		dt_end(&dt_parse);
+#else
+		nnchk(1, "\x1b[92m%s \x1b[0mis zstd-compressed, but ncc was built w/o zstd: rebuild it w/ -DM_ZSTD -l:libzstd.a", filepath);
+#endif
+	}else if(path_endswith(filepath,".nab")){
+		dt_read = dt_ini();  file_t nabfile = file_ini(filepath);  dt_end(&dt_read);  bdim=nabfile.bdim;
+		dt_parse = dt_ini();  nabload(nabfile, verify, &nir);  dt_end(&dt_parse);  // @nir now owns @nabfile
+	}else if(path_endswith(filepath,".nel")){
+		dt_read = dt_ini();  file_t nelfile = file_ini(filepath);  dt_end(&dt_read);  bdim=nelfile.bdim;
+		dt_parse = dt_ini();  nelparse(nelfile.bdim,nelfile.data, &nir);  dt_end(&dt_parse);
+		file_end(&nelfile);
+	}else if(path_endswith(filepath,".nad")){
+		dt_read = dt_ini();  file_t nadfile = file_ini(filepath);  dt_end(&dt_read);  bdim=nadfile.bdim;
+		dt_parse = dt_ini();  nadparse(nadfile.bdim,nadfile.data, &nir);  dt_end(&dt_parse);
+		file_end(&nadfile);
+	}else if(path_endswith(filepath,".nam")){
+		dt_read = dt_ini();  file_t namfile = file_ini(filepath);  dt_end(&dt_read);  bdim=namfile.bdim;
+		u32* P=NULL;
+		dt_parse = dt_ini();  namparse(namfile.bdim,namfile.data, &nir,&P);  dt_end(&dt_parse);
+		file_end(&namfile);
+		free(P);
+	}else{
+		dt_read = dt_ini();  file_t nirfile = file_ini(filepath);  dt_end(&dt_read);  bdim=nirfile.bdim;
+		dt_parse = dt_ini();  nirparse(nirfile.bdim,nirfile.data, nthreads, &nir);  dt_end(&dt_parse);
+		file_end(&nirfile);
+	}
+
+	// ----------------------------------------------------------------  -D: diff the graph against the parent's
+	u8*       reuse = NULL;  // reuse[t] is 1 if TU t is the parent's (see @nirdif_reuse)
+	nir_t     old   = {0x00};
+	u32*      olv   = NULL;  // the parent's levels
+	nirdifh_t oh    = {0x00};
+	nirdif_t  diff  = {0x00};
+	if(!hit && difdir!=NULL){
+		char*  onab  = nccache_path(difdir,"net.nab");
+		char*  olvp  = nccache_path(difdir,"net.lvl");
+		file_t ofile = file_ini(onab);  nnchk(ofile.path==NULL, "can't open \x1b[92m%s\x1b[0m: is \x1b[92m%s \x1b[0man entry of \x1b[35m-K\x1b[0m?", onab,difdir);
+		nabload(ofile, 0, &old);
+		olv = nirdif_load(olvp, &oh);
+		nnchk(oh.opts!=optsh, "\x1b[92m%s \x1b[0mwas built w/ other options (or by another ncc build)", difdir);
+		nnchk(oh.N!=(u64)old.N, "\x1b[92m%s \x1b[0mdoesn't match \x1b[92m%s\x1b[0m: delete \x1b[92m%s\x1b[0m", olvp,onab, difdir);
+		if(batch==0)  batch = oh.B;
+		nirdif_ini(&old,&nir, &diff);
+		free(olvp);  free(onab);
+	}
+
+	// ----------------------------------------------------------------  levelize before anything else sees the graph: this is where cycles get rejected
+	// a hit was levelized when it was built, and it only needs its levels for -J
+	lvl = (nirlvl_t){0x00};
+	if(!hit || jit){
+		dt_lvl = dt_ini();
+		if(olv!=NULL)  nirdif_lvl(&nir,&diff, olv, &lvl);
+		else           nirlvl_ini(&nir,&lvl);
+		dt_end(&dt_lvl);
+		if(nnverbose())  nirlvlshow(&lvl);
+	}
+	if(hit && dif){  // the TUs of the entry, for -o
+		char* p=nccache_path(cache.dir,"net.lvl");  vend(nirdif_load(p, &oh));  free(p);
+		tus = oh.T;
+	}
+
+	// ----------------------------------------------------------------
+	if(nabpath!=NULL)  nabsave(nabpath,&nir, nir.nab.data==NULL ? filepath : NULL);
+	if(!hit && (cpath!=NULL || cachedir!=NULL)){  // w/ -K, the C goes to the cache, and -o gets a copy
+		dt_gen = dt_ini();
+		if(batch==0)  batch = nirbatch(&nir,&lvl);
+		if(dif){
+			u64* pj = nirdif_cut(&nir,&lvl, NCC_DIF_EMAX);
+			tus = vidim(pj);  // TU 0, and 1 per part
+			if(olv!=NULL){
+				nirlvl_t ol;  nirlvl_idx(old.N, olv,nirdif_L(olv), &ol);  olv=NULL;  // @ol owns the levels now
+				reuse = nirdif_reuse(&old,&ol, &lvl, &diff, pj);
+				nirlvl_end(&ol);
+			}
+			nirdif_gen(cachedir!=NULL ? cache.cpath : cpath,filepath, &nir,&lvl, batch, rt, pj, reuse);
+			vend(pj);
+		}else  nirgen(cachedir!=NULL ? cache.cpath : cpath,filepath, &nir,&lvl, share, grad, batch, sellc, unroll, tus, rt);
+		dt_end(&dt_gen);
+	}
+	if(!hit && cachedir!=NULL){  // net.so goes last: it's what marks the entry complete
+		nabsave(cache.nabpath,&nir, NULL);
+		if(dif){  char* p=nccache_path(cache.dir,"net.lvl");  nirdif_save(p, (nirdifh_t){opts:optsh, N:nir.N, T:tus, B:batch}, &lvl);  free(p);  }
+		if(reuse!=NULL)  nccache_reuse(&cache, difdir, tus, reuse);
+		dt_cc = dt_ini();  nccache_put(&cache, grad, tus, reuse);  dt_end(&dt_cc);
+	}
+	if(cachedir!=NULL && cpath!=NULL)  nccache_copytu(cache.cpath, cpath, tus);  // its NCC_CSR_PATH (if any) is the entry's .csr
+	if(rt && cpath!=NULL){  char* dir=nccrt_dir(cpath);  nccrt_put(dir,"");  free(dir);  }
+	nirjit_t njit = {0x00};
+	if(jit){  // time 1 fwd over dummy inputs and weights, after 1 warm-up call
+		dt_jit = dt_ini();  nirjit_ini(&nir,&lvl, 1.0f, &njit);  dt_end(&dt_jit);
+		i64  NX=0, NY=0;  mfor(j,0,nir.N){  NX += nir_idim(&nir,j)==0;  NY += nir_idim(&nir,j)!=0 && nir_odim(&nir,j)==0;  }
+		f32* x = malloc(Bsize(f32)*mmax(NX,1));  mfor(k,0,NX)     x[k]=0.5f;
+		f32* y = malloc(Bsize(f32)*mmax(NY,1));
+		f32* w = malloc(Bsize(f32)*mmax(nir.E,1));  mfor(e,0,nir.E)  w[e]=0.01f;
+		i64  R = mmax(1, 0x1000000/mmax(nir.E,1));
+		njit.fwd(x,y,w);
+		dt_t dt_fwd = dt_ini();  mfor(r,0,R)  njit.fwd(x,y,w);  dt_end(&dt_fwd);
+		tfwd = 1e9*dt_del(dt_fwd)/R;
+		free(w);  free(y);  free(x);
+	}
+	dt_end(&dt_all);
+	fflush(nnlog);
+	if(NCC_SUMMARY<=ncc_lvl){
+		print("\x1b[92mncc  \x1b[0m%c  N \x1b[34m%,d  \x1b[0mE \x1b[34m%,d  ", filepath, nir.N,nir.E);
+		if(!hit || jit)    print("\x1b[0mL \x1b[34m%,d  ", lvl.L);  // a hit isn't levelized
+		print("\x1b[0mread \x1b[32m%.6f  \x1b[0mparse \x1b[32m%.6f \x1b[0m(\x1b[34m%,d \x1b[0mMB/s)  \x1b[0mlvl \x1b[32m%.6f  \x1b[0mgen \x1b[32m%.6f  \x1b[0mtotal \x1b[32m%.6f \x1b[0ms", dt_del(dt_read),dt_del(dt_parse),(i64)(bdim/1e6/mmax(dt_del(dt_parse),1e-9)),dt_del(dt_lvl),dt_del(dt_gen),dt_del(dt_all));
+		if(cachedir!=NULL) print("  \x1b[0mcache %c \x1b[32m%.6f  \x1b[0mcc \x1b[32m%.6f \x1b[0ms  \x1b[91m> \x1b[92m%c\x1b[0m", hit ? "\x1b[92mhit" : "\x1b[91mmiss", dt_del(dt_cache),dt_del(dt_cc), cache.sopath);
+		if(reuse!=NULL){   i64 R=0;  mfor(t,1,tus)  R+=reuse[t];  print("  \x1b[0mdif \x1b[34m%,d \x1b[0mchanged  \x1b[34m%,d \x1b[0mcone  \x1b[34m%,d\x1b[0m/\x1b[34m%,d \x1b[0mparts reused", diff.C,diff.K, R,tus-1);  }
+		if(jit)            print("  \x1b[0mjit \x1b[32m%.6f \x1b[0ms (\x1b[34m%,d \x1b[0mB)  fwd \x1b[32m%.1f \x1b[0mns", dt_del(dt_jit),njit.bdim,tfwd);
+		if(nabpath!=NULL)  print("  \x1b[91m> \x1b[92m%c\x1b[0m", nabpath);
+		if(cpath  !=NULL)  print("  \x1b[91m> \x1b[92m%c\x1b[0m", cpath);
+		print("\n");
+	}
+	nirjit_end(&njit);
+	if(reuse!=NULL)  vend(reuse);
+	if(olv!=NULL)    vend(olv);
+	nirdif_end(&diff);
+	nir_end(&old);
+	nccache_end(&cache);
+	nirlvl_end(&lvl);
+	nir_end(&nir);
 	exit(0);
 }
 